@@ -0,0 +1,48 @@
+#!/bin/bash
+#
+# Times the code generator on synthetic programs of growing size.
+# Every class has attributes that are read and assigned and a method that
+# dispatches to its parent's method, so the run exercises the attribute
+# and dispatch layout tables. If codegen is linear the last column (time
+# per class) should stay flat as the number of classes doubles.
+#
+#   ./bench_cgen.sh [sizes...]        default sizes: 250 500 1000 2000
+#
+
+SIZES=${*:-"250 500 1000 2000"}
+TMP=${TMPDIR:-/tmp}/bench_cgen.$$
+mkdir -p $TMP
+
+gen_program() {
+	n=$1
+	echo "class C1 inherits IO {"
+	echo "  a1 : Int <- 1;"
+	echo "  b1 : Int;"
+	echo "  m1(x : Int) : Int { { b1 <- a1 + x; a1; } };"
+	echo "};"
+	for ((i = 2; i <= n; i++)); do
+		p=$((i / 2))
+		echo "class C$i inherits C$p {"
+		echo "  a$i : Int <- $i;"
+		echo "  b$i : Int;"
+		echo "  m$i(x : Int) : Int { { b$i <- a$i + x; a$p <- m$p(b$i); self.m$p(a$i); } };"
+		echo "};"
+	done
+	echo "class Main {"
+	echo "  c : C$n <- new C$n;"
+	echo "  main() : Object { c.m$n(1) };"
+	echo "};"
+}
+
+printf "%8s %10s %14s\n" classes seconds us/class
+for n in $SIZES; do
+	f=$TMP/bench$n.cl
+	gen_program $n > $f
+	./lexer $f | ./parser $f | ./semant $f > $TMP/bench$n.ast
+	start=$(date +%s.%N)
+	./cgen < $TMP/bench$n.ast > /dev/null
+	end=$(date +%s.%N)
+	echo "$n $start $end" | awk '{ t = $3 - $2; printf "%8d %10.3f %14.1f\n", $1, t, t * 1000000 / $1 }'
+done
+
+rm -rf $TMP
@@ -0,0 +1,49 @@
+#!/bin/bash
+#
+# Times coolc's front end (lexing and parsing) on a program split across
+# many files, with the lexer running on 1, 2, 4, ... threads up to the
+# number of cores. Each file holds a few classes with commented methods,
+# strings and arithmetic. coolc -v reports the front end's wall time.
+#
+#   ./bench_frontend.sh [files] [classes per file]   default: 64 50
+#
+
+FILES=${1:-64}
+CLASSES=${2:-50}
+TMP=${TMPDIR:-/tmp}/bench_frontend.$$
+mkdir -p $TMP
+
+gen_file() {
+	f=$1
+	for ((i = 1; i <= CLASSES; i++)); do
+		c=F${f}C$i
+		echo "(* class $c: one of $CLASSES in file $f *)"
+		echo "class $c inherits IO {"
+		echo "  n : Int <- $i;"
+		echo "  s : String <- \"class $c\\tfile $f\\n\";"
+		echo "  -- adds x to n, then prints s"
+		echo "  m(x : Int) : Object {"
+		echo "    { n <- n + x * 2 - (x / 3);"
+		echo "      if n < 100 then out_string(s) else out_int(n) fi; }"
+		echo "  };"
+		echo "};"
+	done
+}
+
+files=""
+for ((f = 1; f <= FILES; f++)); do
+	gen_file $f > $TMP/file$f.cl
+	files="$files $TMP/file$f.cl"
+done
+echo "class Main { main() : Object { 0 }; };" > $TMP/main.cl
+files="$files $TMP/main.cl"
+
+cores=$(nproc)
+printf "%8s %10s\n" threads seconds
+for ((t = 1; t <= cores; t *= 2)); do
+	secs=$(COOLC_THREADS=$t ./coolc -v -o $TMP/out.s $files 2>&1 | \
+		awk '/^front end:/ { print $(NF-1) }')
+	printf "%8d %10s\n" $t "$secs"
+done
+
+rm -rf $TMP
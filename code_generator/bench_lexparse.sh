@@ -0,0 +1,94 @@
+#!/bin/bash
+#
+# Measures the lexer and the parser separately on synthetic programs of
+# several shapes, with frontbench (make frontbench). For every shape and
+# size it reports MB/s and tokens/s for the lexer, tokens/s and AST
+# nodes/s for the parser, and how much each grew the resident set.
+#
+#   classes   many small classes with attributes and methods
+#   nesting   methods whose bodies nest ifs, lets and parentheses deeply
+#   strings   attributes initialized with long escaped string literals
+#   comments  a few features buried in nested and line comments
+#
+#   ./bench_lexparse.sh [-n reps] [-s "shapes..."] [sizes...]
+#                       default: 5 reps, every shape, sizes 200 800
+#
+
+REPS=5
+SHAPES="classes nesting strings comments"
+while getopts "n:s:" opt; do
+	case $opt in
+	n) REPS=$OPTARG ;;
+	s) SHAPES=$OPTARG ;;
+	*) exit 1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+SIZES=${*:-"200 800"}
+TMP=${TMPDIR:-/tmp}/bench_lexparse.$$
+mkdir -p $TMP
+
+gen_classes() {
+	for ((i = 1; i <= $1; i++)); do
+		echo "class C$i inherits IO {"
+		echo "  a : Int <- $i;"
+		echo "  b : String <- \"c$i\";"
+		echo "  f(x : Int, y : Int) : Int { a <- a + x * y };"
+		echo "  g() : Object { out_string(b.concat(\"\\n\")) };"
+		echo "};"
+	done
+}
+
+gen_nesting() {
+	depth=40
+	for ((i = 1; i <= $1; i++)); do
+		echo "class C$i {"
+		echo "  n : Int;"
+		printf "  f(x : Int) : Int {\n    "
+		for ((d = 0; d < depth; d++)); do printf "if x < $d then ("; done
+		printf "let y : Int <- x in y + n"
+		for ((d = 0; d < depth; d++)); do printf ") else x fi"; done
+		printf "\n  };\n"
+		echo "};"
+	done
+}
+
+gen_strings() {
+	line=""
+	for ((k = 0; k < 40; k++)); do line="${line}string\\tpart $k\\n "; done
+	for ((i = 1; i <= $1; i++)); do
+		echo "class C$i {"
+		echo "  s1 : String <- \"$line\";"
+		echo "  s2 : String <- \"\\\"quoted\\\" $line\";"
+		echo "};"
+	done
+}
+
+gen_comments() {
+	for ((i = 1; i <= $1; i++)); do
+		echo "(* class C$i"
+		for ((k = 0; k < 10; k++)); do
+			echo "   a long comment line $k about the class, (* nested $k *) and more"
+		done
+		echo "*)"
+		echo "class C$i {"
+		echo "  -- the counter; this line comment is longer than the code"
+		echo "  n : Int <- $i; -- the initial value"
+		echo "  -- adds one"
+		echo "  f() : Int { n <- n + 1 };"
+		echo "};"
+	done
+}
+
+for shape in $SHAPES; do
+	for n in $SIZES; do
+		f=$TMP/$shape$n.cl
+		gen_$shape $n > $f
+		echo "class Main { main() : Object { 0 }; };" >> $f
+		echo "== $shape, $n classes, $(wc -c < $f) bytes"
+		./frontbench -l -n $REPS $f
+		./frontbench -p -n $REPS $f | tail -1
+	done
+done
+
+rm -rf $TMP
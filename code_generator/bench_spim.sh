@@ -0,0 +1,50 @@
+#!/bin/bash
+#
+# Compares the code generated under different coolc flags by the number
+# of instructions spim executes. Every program is compiled once per
+# configuration and run with spim -keepstats; set SPIM to use another
+# simulator binary. A second table gives the number of objects the
+# compiled code allocated, from a build with COOLC_COUNT_ALLOCS set.
+#
+#   stack   -r   every intermediate value goes through the stack
+#   regs         arithmetic intermediates in temporary registers
+#   optimize -O  regs, devirtualized dispatch and the peephole pass
+#
+#   ./bench_spim.sh [programs...]     default: every .cl file here
+#
+
+SPIM=${SPIM:-spim}
+NAMES=(stack regs optimize)
+FLAGS=("-r" "" "-O")
+PROGRAMS=${*:-*.cl}
+TMP=${TMPDIR:-/tmp}/bench_spim.$$
+mkdir -p $TMP
+
+# table TITLE PATTERN [VAR=value]: for each program and configuration,
+# the last field of the spim output line matching PATTERN
+table() {
+	printf "%-20s" "$1"
+	for name in "${NAMES[@]}"; do printf " %12s" $name; done
+	echo
+
+	for prog in $PROGRAMS; do
+		printf "%-20s" $(basename $prog)
+		for ((c = 0; c < ${#NAMES[@]}; c++)); do
+			out=$TMP/${NAMES[$c]}.s
+			if env $3 ./coolc ${FLAGS[$c]} -o $out $prog > /dev/null 2>&1; then
+				count=$($SPIM -keepstats -file $out < /dev/null 2>&1 | \
+					awk "/$2/ { print \$NF }")
+			else
+				count=""
+			fi
+			printf " %12s" ${count:-error}
+		done
+		echo
+	done
+}
+
+table instructions "#instructions"
+echo
+table allocations "allocations:" COOLC_COUNT_ALLOCS=1
+
+rm -rf $TMP
@@ -27,8 +27,35 @@
 #include <map>
 #include <vector>
 #include <queue>
+#include <chrono>
+#include <algorithm>
+#include <set>
+#include <climits>
 extern void emit_string_constant(ostream& str, char *s);
 extern int cgen_debug;
+extern int disable_reg_alloc;
+extern int cgen_optimize;
+
+//
+// Registers for expression temporaries. An arithmetic node keeps its left
+// operand in the next free one while the right operand is evaluated,
+// instead of pushing it on the stack. They are caller-saved, so this is
+// only done when the right operand makes no call (see temps_needed).
+//
+// That is all the register allocation there is. Dispatch arguments and
+// let and case variables still live on the stack, $s1-$s7 are never
+// used, and there is no allocator over whole method bodies.
+// bench_spim.sh compares the executed instruction counts with and
+// without -r.
+//
+static char *temp_regs[] = { "$t2", "$t3", "$t4", "$t5", "$t6", "$t7", "$t8", "$t9" };
+#define NUM_TEMP_REGS 8
+
+// temps_needed of an expression that calls a method or the runtime
+#define MAKES_CALL 1000
+
+// how deep inlined bodies may nest
+#define INLINE_DEPTH 3
 
 class GlobalCGenState;
 
@@ -36,6 +63,16 @@ class GlobalCGenState
 {
   private:
         int label_cntr;
+        int temps_in_use;
+        int folds;                      // constant subtrees coded as one value
+        int boxes;                      // Int results allocated at run time
+        int dispatches;
+        int direct_calls;               // dispatches devirtualized to a jal
+        int inline_size;                // largest body inlined, in AST nodes
+        int inlined;                    // dispatches replaced by a body
+        std::vector<Feature> inlining;  // methods being inlined, innermost last
+        std::vector<std::map<Symbol, Expression> > inline_args;  // their formals
+        bool count_allocs;              // count allocations at run time
 
   public:
 	CgenClassTable *classtableptr;	
@@ -43,6 +80,51 @@ class GlobalCGenState
 	SymbolTable<Symbol,Symbol> *symtab;
         void init_label_cntr() { label_cntr = -1; } 
 	int increment_label_cntr() { return label_cntr = label_cntr + 1; }
+        void init_temps() { temps_in_use = 0; folds = boxes = 0; dispatches = direct_calls = 0; }
+        int free_temps() { return NUM_TEMP_REGS - temps_in_use; }
+        char *alloc_temp() { return temp_regs[temps_in_use++]; }
+        void release_temp() { temps_in_use--; }
+        void count_fold() { folds++; }
+        void count_box() { boxes++; }
+        int get_folds() { return folds; }
+        int get_boxes() { return boxes; }
+        void count_dispatch(bool direct) { dispatches++; if (direct) direct_calls++; }
+        int get_dispatches() { return dispatches; }
+        int get_direct_calls() { return direct_calls; }
+        void init_inlining() {
+          char *size = getenv("COOLC_INLINE_SIZE");
+          inline_size = size ? atoi(size) : 8;
+          inlined = 0;
+        }
+        bool can_inline() { return inline_size > 0 && inline_args.size() < INLINE_DEPTH; }
+        bool can_inline(Feature method) {
+          Expression body = method->get_feat_expr();
+          return std::find(inlining.begin(), inlining.end(), method) == inlining.end() &&
+                 body->tree_size() <= inline_size && !body->rebinds(method->get_formals());
+        }
+        void begin_inline(Feature method, Expressions actual) {
+          std::map<Symbol, Expression> args;
+          Formals formals = method->get_formals();
+          for (int i = formals->first(); formals->more(i); i = formals->next(i))
+            args[formals->nth(i)->get_name()] = actual->nth(i);
+          inlining.push_back(method);
+          inline_args.push_back(args);
+          inlined++;
+        }
+        void end_inline() { inlining.pop_back(); inline_args.pop_back(); }
+        // the method being emitted sits at the bottom of the inlining stack,
+        // so a recursive call is never inlined into its own body
+        void enter_method(Feature method) { inlining.push_back(method); }
+        void exit_method() { inlining.pop_back(); }
+        // the constant a formal of the method being inlined stands for
+        Expression inline_arg(Symbol name) {
+          if (inline_args.empty()) return NULL;
+          std::map<Symbol, Expression>::iterator arg = inline_args.back().find(name);
+          return arg == inline_args.back().end() ? NULL : arg->second;
+        }
+        int get_inlined() { return inlined; }
+        void init_alloc_count() { count_allocs = getenv("COOLC_COUNT_ALLOCS") != NULL; }
+        bool counts_allocs() { return count_allocs; }
 };
 
 GlobalCGenState cgen_state;
@@ -168,6 +250,9 @@ void program_class::cgen(ostream &os)
   os << "# start of generated code\n";
 
   cgen_state.init_label_cntr();
+  cgen_state.init_temps();
+  cgen_state.init_inlining();
+  cgen_state.init_alloc_count();
   // Set up the symbol table, must have an initial scope to add things to
   //cgen_state.symtab = new SymbolTable<Symbol,Symbol>();
   //cgen_state.symtab->enterscope();
@@ -276,6 +361,19 @@ static void emit_sub(char *dest, char *src1, char *src2, ostream& s)
 static void emit_sll(char *dest, char *src1, int num, ostream& s)
 { s << SLL << dest << " " << src1 << " " << num << endl; }
 
+// reg1 <- 1 if reg2 < reg3, 0 otherwise
+static void emit_slt(char *dest, char *src1, char *src2, ostream& s)
+{ s << SLT << dest << " " << src1 << " " << src2 << endl; }
+
+static void emit_sltiu(char *dest, char *src1, int imm, ostream& s)
+{ s << SLTIU << dest << " " << src1 << " " << imm << endl; }
+
+static void emit_xor(char *dest, char *src1, char *src2, ostream& s)
+{ s << XOR << dest << " " << src1 << " " << src2 << endl; }
+
+static void emit_xori(char *dest, char *src1, int imm, ostream& s)
+{ s << XORI << dest << " " << src1 << " " << imm << endl; }
+
 static void emit_jalr(char *dest, ostream& s)
 { s << JALR << "\t" << dest << endl; }
 
@@ -379,6 +477,18 @@ static void emit_push(char *reg, ostream& str)
   emit_addiu(SP,SP,-4,str);
 }
 
+//
+// Pop the top of the stack into a register. The pop comes right after
+// the code that needed the value kept on the stack, before the value is
+// used, so that with -O the peephole pass finds the push and the pop
+// with nothing but that code between them.
+//
+static void emit_pop(char *reg, ostream& str)
+{
+  emit_load(reg,1,SP,str);
+  emit_addiu(SP,SP,4,str);
+}
+
 //
 // Fetch the integer value in an Int object.
 // Emits code to fetch the integer value of the Integer object pointed
@@ -405,6 +515,38 @@ static void emit_test_collector(ostream &s)
   emit_load(ACC,0,SP,s);
 }
 
+//
+// Allocation counts, for bench_spim.sh. With COOLC_COUNT_ALLOCS set in
+// the environment, each Object.copy the compiler emits (new and Int
+// boxing) adds one to the word at _alloc_count, and Main.main prints the
+// total before it returns. No temporary holds a value across the call,
+// so $t1 and $t2 are free right after it.
+//
+static void emit_count_alloc(ostream &s)
+{
+  if (!cgen_state.counts_allocs()) return;
+  emit_load_address(T1, ALLOC_COUNT, s);
+  emit_load(T2, 0, T1, s);
+  emit_addiu(T2, T2, 1, s);
+  emit_store(T2, 0, T1, s);
+}
+
+static void emit_print_alloc_count(ostream &s)
+{
+  emit_move(T1, ACC, s);
+  emit_load_address(ACC, ALLOC_COUNT_MSG, s);
+  emit_load_imm(V0, 4, s);            // print_string
+  s << SYSCALL << endl;
+  emit_load_address(ACC, ALLOC_COUNT, s);
+  emit_load(ACC, 0, ACC, s);
+  emit_load_imm(V0, 1, s);            // print_int
+  s << SYSCALL << endl;
+  emit_load_imm(ACC, '\n', s);
+  emit_load_imm(V0, 11, s);           // print_char
+  s << SYSCALL << endl;
+  emit_move(ACC, T1, s);
+}
+
 static void emit_gc_check(char *source, ostream &s)
 {
   if (source != (char*)A1) emit_move(A1, source, s);
@@ -666,6 +808,11 @@ void CgenClassTable::code_global_data()
       << WORD << boolclasstag << endl;
   str << STRINGTAG << LABEL 
       << WORD << stringclasstag << endl;
+  if (cgen_state.counts_allocs()) {
+    str << ALLOC_COUNT << LABEL << WORD << 0 << endl;
+    str << ALLOC_COUNT_MSG << LABEL << "\t.asciiz\t\"allocations: \"" << endl;
+    str << ALIGN;
+  }
 	// loop through each of the classes
 	// and print out their values
 
@@ -747,6 +894,14 @@ void CgenClassTable::code_constants()
   stringtable.add_string("");
   inttable.add_string("0");
 
+  // and the Int results constant folding will produce (see add_constants)
+  for(List<CgenNode> *l = nds; l; l = l->tl())
+  {
+    Features feats = l->hd()->get_features();
+    for(int i = feats->first(); feats->more(i); i = feats->next(i))
+      feats->nth(i)->get_feat_expr()->add_constants();
+  }
+
   stringtable.code_string_table(str,stringclasstag);
   inttable.code_string_table(str,intclasstag);
   code_bools(boolclasstag);
@@ -769,6 +924,22 @@ void CgenClassTable::traverse(CgenNodeP nd) {
 
   class_tags.insert(std::make_pair( nd, increase_class_tag()));
 }
+  nd->set_tag(class_tags[nd]);
+  tag_of_class.insert(std::make_pair(nd->get_name(), nd->get_tag()));
+
+  // lay out the attributes: start from a copy of the parent's layout (the
+  // parent was traversed first), then append our own attributes
+  if((int)attr_layouts.size() <= nd->get_tag()) attr_layouts.resize(nd->get_tag() + 1);
+  if(nd != root()) attr_layouts[nd->get_tag()] = attr_layouts[nd->get_parentnd()->get_tag()];
+  AttrLayout &layout = attr_layouts[nd->get_tag()];
+  Features own_feats = nd->get_features();
+  for(int i = own_feats->first(); own_feats->more(i); i = own_feats->next(i)){
+    Feature feat = own_feats->nth(i);
+    if(!feat->feat_is_method()){
+      layout.offset[feat->get_feature_name()] = DEFAULT_OBJFIELDS + layout.attrs.size();
+      layout.attrs.push_back(feat);
+    }
+  }
 
   // get all of the features for the current node we are at
   if(nd == root()){ features_map.insert(std::make_pair(nd, nd->get_features()));
@@ -814,7 +985,8 @@ void CgenClassTable::traverse(CgenNodeP nd) {
   }
 }
 
-CgenClassTable::CgenClassTable(Classes classes, ostream& s) : nds(NULL) , str(s)
+CgenClassTable::CgenClassTable(Classes classes, ostream& s) : nds(NULL) , asm_buf(s) , peephole(&asm_buf) ,
+  asm_out(cgen_optimize ? (std::streambuf *) &peephole : &asm_buf) , str(asm_out)
 {
 
   cgen_state.classtableptr = this;
@@ -830,6 +1002,8 @@ CgenClassTable::CgenClassTable(Classes classes, ostream& s) : nds(NULL) , str(s)
   build_inheritance_tree();
   init_class_tag();
   traverse(root());
+  build_dispatch_layouts();
+  find_unique_targets(root());
 
   //at index 0, 1, 2, 3 etc 
 
@@ -1052,120 +1226,167 @@ void CgenClassTable::print_class_obj_tab(){
 
 /*
   Iterate through the features map, which has a list of all the CGenNodes
-  Get a node, and the node's name. For that node's method map, we print
-  out every single method. This is the dispatch table.
+  Get a node, and the node's name. For that node's dispatch layout, we print
+  out every single method slot. This is the dispatch table.
 */
 void CgenClassTable::print_dispatch_tables(){
-  std::map<CgenNodeP, Features>::iterator it = (get_features_map()).begin();
-  while(it != get_features_map().end())
+  std::map<CgenNodeP, Features>::iterator it = features_map.begin();
+  while(it != features_map.end())
   {
     CgenNodeP curr_node = it->first;
+    DispatchLayout &layout = dispatch_layouts[curr_node->get_tag()];
 
     str<<curr_node->get_name() << DISPTAB_SUFFIX << ":" << endl;
-    std::map< std::string, CgenNodeP>::iterator iter = (curr_node->method_map.begin());
-
-    while (iter!= curr_node->method_map.end()){
-      str<< WORD << iter->second->get_name() << METHOD_SEP << iter->first <<endl;
-      iter++;
+    for(size_t slot = 0; slot < layout.slot_names.size(); slot++)
+    {
+      str<< WORD << layout.slot_owners[slot]->get_name() << METHOD_SEP << layout.slot_names[slot] <<endl;
     }
     it++;
   }
 }
 
-int CgenClassTable::get_method_offset (std::string method_name, std::string node_name){
-CgenNodeP nd; 
-std::map<CgenNodeP, int>::iterator it = (class_tags.begin());
-  while(it != class_tags.end())
+/*
+  Lay out the dispatch table of every class once, right after traverse().
+  Like the attribute layouts, a class's table starts as a copy of its
+  parent's: a method the class overrides keeps the parent's slot, and
+  methods the class adds go at the end. A method therefore has the same
+  slot in every class that has it, so the offset taken from the static
+  type of a dispatch is right for any dynamic type, and the tables
+  printed by print_dispatch_tables agree with it.
+
+  dispatch_layouts is indexed by class tag, and each layout hashes the
+  method name to its slot, so a dispatch site costs two hash probes
+  instead of a walk over every class and every method.
+*/
+void CgenClassTable::build_dispatch_layouts()
+{
+  int max_tag = 0;
+  std::map<CgenNodeP, int>::iterator it = class_tags.begin();
+  for(; it != class_tags.end(); it++)
   {
-    if(it->first->get_name()->get_string() == node_name){
+    if(it->second > max_tag) max_tag = it->second;
+  }
+  dispatch_layouts.resize(max_tag + 1);
+  build_dispatch_layout(root());
+}
 
-      nd= it->first;
-    }
-    it++;
+void CgenClassTable::build_dispatch_layout(CgenNodeP nd)
+{
+  DispatchLayout &layout = dispatch_layouts[nd->get_tag()];
+  if(nd != root()) layout = dispatch_layouts[nd->get_parentnd()->get_tag()];
 
-  }
-int offset = 0; 
-std::map< std::string, CgenNodeP>::iterator iter = (nd->method_map.begin());
- 
-  while (iter!= nd->method_map.end()){
-    if(iter->first == method_name) return offset;
-    offset+=1;
-    iter++; 
+  Features feats = nd->get_features();
+  for(int i = feats->first(); feats->more(i); i = feats->next(i))
+  {
+    Feature feat = feats->nth(i);
+    if(!feat->feat_is_method()) continue;
+    Symbol method_name = feat->get_feature_name();
+    std::unordered_map<Symbol, int>::iterator slot = layout.slot_index.find(method_name);
+    if(slot != layout.slot_index.end()){
+      layout.slot_owners[slot->second] = nd;
+    }else{
+      layout.slot_index.insert(std::make_pair(method_name, (int)layout.slot_names.size()));
+      layout.slot_names.push_back(method_name);
+      layout.slot_owners.push_back(nd);
+    }
   }
 
-  return 0;
+  for(List<CgenNode> *l = nd->get_children(); l; l = l->tl())
+    build_dispatch_layout(l->hd());
 }
 
 /*
+  Class hierarchy analysis: a dispatch on an object whose static class is
+  nd can only reach the method defined for nd if no subclass of nd
+  overrides it. Fills in unique_owners for nd and, first, for every class
+  below it.
 */
+void CgenClassTable::find_unique_targets(CgenNodeP nd)
+{
+  for(List<CgenNode> *l = nd->get_children(); l; l = l->tl())
+    find_unique_targets(l->hd());
 
-
-int CgenClassTable::get_attribute_offset (std::string attribute, CgenNodeP nd){
-
-int offset = 3; 
-std::map<CgenNodeP, Features>::iterator it = (get_features_map()).begin();
-    
-    while(it != get_features_map().end())
+  DispatchLayout &layout = dispatch_layouts[nd->get_tag()];
+  layout.unique_owners = layout.slot_owners;
+  for(size_t slot = 0; slot < layout.slot_names.size(); slot++)
+  {
+    for(List<CgenNode> *l = nd->get_children(); l; l = l->tl())
     {
-      if (it ->first->get_name()->get_string() == nd->get_name()->get_string()){
-        Features curr_attributes = it->second;
-
-          for(int j = curr_attributes->first(); curr_attributes->more(j); j = curr_attributes->next(j)){
+      DispatchLayout &child = dispatch_layouts[l->hd()->get_tag()];
+      std::unordered_map<Symbol, int>::iterator child_slot = child.slot_index.find(layout.slot_names[slot]);
+      if(child_slot == child.slot_index.end() ||
+         child.unique_owners[child_slot->second] != layout.slot_owners[slot])
+        layout.unique_owners[slot] = NULL;
+    }
+  }
+}
 
-             Feature attr = curr_attributes->nth(j);
+/*
+  The only class whose method_name a dispatch on class_name can call, or
+  NULL if subclasses override it or the class or method is unknown.
+*/
+CgenNodeP CgenClassTable::get_unique_target (Symbol method_name, Symbol class_name){
+  std::unordered_map<Symbol, int>::iterator tag = tag_of_class.find(class_name);
+  if(tag == tag_of_class.end()) return NULL;
 
-            if(attr->get_feature_name()->get_string() == attribute){
+  DispatchLayout &layout = dispatch_layouts[tag->second];
+  std::unordered_map<Symbol, int>::iterator slot = layout.slot_index.find(method_name);
+  if(slot == layout.slot_index.end()) return NULL;
+  return layout.unique_owners[slot->second];
+}
 
-              return offset;
-            }
-             if(!attr->feat_is_method()){
-                offset +=1; 
-             }
+/*
+  Slot of method_name in the dispatch table of class_name, or 0 if the
+  class or method is unknown.
+*/
+int CgenClassTable::get_method_offset (Symbol method_name, Symbol class_name){
+  std::unordered_map<Symbol, int>::iterator tag = tag_of_class.find(class_name);
+  if(tag == tag_of_class.end()) return 0;
 
-      }
+  DispatchLayout &layout = dispatch_layouts[tag->second];
+  std::unordered_map<Symbol, int>::iterator slot = layout.slot_index.find(method_name);
+  if(slot == layout.slot_index.end()) return 0;
+  return slot->second;
 }
-it++;
 
-}
-return 0;
+/*
+*/
+
+
+/*
+  Word offset of attribute inside objects of class nd, or 0 if nd has no
+  such attribute. The layouts are computed once in traverse().
+*/
+int CgenClassTable::get_attribute_offset (Symbol attribute, CgenNodeP nd){
+  AttrLayout &layout = attr_layouts[nd->get_tag()];
+  std::unordered_map<Symbol, int>::iterator it = layout.offset.find(attribute);
+  if(it == layout.offset.end()) return 0;
+  return it->second;
 }
 
 
 void CgenClassTable::print_node_attrs()
 {
-  std::map<CgenNodeP, Features>::iterator it = (get_features_map()).begin();
-  while(it != get_features_map().end())
+  std::map<CgenNodeP, Features>::iterator it = features_map.begin();
+  while(it != features_map.end())
   {
-  
-      str<< it->first->get_name() << PROTOBJ_SUFFIX << ":" << endl;
-      Features curr_attributes = it->second;
-      int count = 0;
-      for(int j = curr_attributes->first(); curr_attributes->more(j); j = curr_attributes->next(j))
-      {
-        Feature count_at = curr_attributes->nth(j);
+      AttrLayout &layout = attr_layouts[it->first->get_tag()];
 
-        if(!count_at->feat_is_method()){
-          count++;
-        }
-      }
+      str<< it->first->get_name() << PROTOBJ_SUFFIX << ":" << endl;
       str << WORD << class_tags[it->first] << endl;
-      str << WORD << count+3 << endl; //size
+      str << WORD << DEFAULT_OBJFIELDS + layout.attrs.size() << endl; //size
       str << WORD << it->first->get_name() << DISPTAB_SUFFIX << endl;
-      for(int i = curr_attributes->first(); curr_attributes->more(i); i = curr_attributes->next(i))
+      for(size_t i = 0; i < layout.attrs.size(); i++)
       {
-        Feature curr_attr = curr_attributes->nth(i);
-        Symbol attr_type = curr_attr->get_type_decl();
-        if(!curr_attr->feat_is_method())
-        {
-          if(attr_type == Bool) {
-            str << WORD; falsebool.code_ref(str); str<<endl;
-          }else if(attr_type == Str){
-            str << WORD; (stringtable.lookup_string(""))->code_ref(str); str<<endl;
-          } else if (attr_type == Int){
-            str << WORD; (inttable.lookup_string("0"))->code_ref(str); str<<endl;
-          } else {
-            str << WORD << EMPTYSLOT <<endl;
-          }
+        Symbol attr_type = layout.attrs[i]->get_type_decl();
+        if(attr_type == Bool) {
+          str << WORD; falsebool.code_ref(str); str<<endl;
+        }else if(attr_type == Str){
+          str << WORD; (stringtable.lookup_string(""))->code_ref(str); str<<endl;
+        } else if (attr_type == Int){
+          str << WORD; (inttable.lookup_string("0"))->code_ref(str); str<<endl;
+        } else {
+          str << WORD << EMPTYSLOT <<endl;
         }
     }
     str << WORD << -1 <<endl;
@@ -1251,6 +1472,21 @@ void CgenClassTable::code()
   //   str << GLOBAL; myclass.code_ref(str);  str << endl;
   // }
   print_methods();
+  if (cgen_debug) cout << "folded " << cgen_state.get_folds() << " constant expressions, "
+                       << cgen_state.get_boxes() << " Int results boxed" << endl;
+  if (cgen_debug) cout << "devirtualized " << cgen_state.get_direct_calls() << " of "
+                       << cgen_state.get_dispatches() << " dispatch sites, inlined "
+                       << cgen_state.get_inlined() << endl;
+
+  if (cgen_optimize) {
+    peephole.flush_output();
+    if (cgen_debug) cout << "peephole pass removed " << peephole.get_removed()
+                         << " instructions" << endl;
+  }
+  asm_buf.flush_output();
+  if (cgen_debug) cout << "wrote " << asm_buf.get_bytes() << " bytes of assembly in "
+                       << asm_buf.get_flushes() << " writes ("
+                       << asm_buf.get_flush_seconds() << "s)" << endl;
 }
 
 
@@ -1337,6 +1573,390 @@ CgenNodeP CgenClassTable::root()
 }
 
 
+///////////////////////////////////////////////////////////////////////
+//
+// AsmBuffer methods
+//
+///////////////////////////////////////////////////////////////////////
+
+AsmBuffer::AsmBuffer(ostream& o) :
+   out(o),
+   buf(INITIAL_SIZE),
+   bytes(0),
+   flushes(0),
+   flush_seconds(0)
+{
+   setp(&buf[0], &buf[0] + buf.size());
+}
+
+//
+// Called when the put area is full. Grow the buffer until it reaches
+// FLUSH_LIMIT, after that write it out and start over.
+//
+int AsmBuffer::overflow(int c)
+{
+   size_t used = pptr() - pbase();
+   if (used >= FLUSH_LIMIT) {
+      flush_output();
+   } else {
+      buf.resize(buf.size() * 2);
+      setp(&buf[0], &buf[0] + buf.size());
+      pbump(used);
+   }
+   if (c != traits_type::eof())
+      return sputc(c);
+   return traits_type::not_eof(c);
+}
+
+void AsmBuffer::flush_output()
+{
+   size_t used = pptr() - pbase();
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   out.write(pbase(), used);
+   out.flush();
+   flush_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   bytes += used;
+   flushes++;
+   setp(&buf[0], &buf[0] + buf.size());
+}
+
+
+///////////////////////////////////////////////////////////////////////
+//
+// PeepholeBuffer methods
+//
+///////////////////////////////////////////////////////////////////////
+
+PeepholeBuffer::PeepholeBuffer(std::streambuf *o) : out(o), removed(0) { }
+
+int PeepholeBuffer::overflow(int c)
+{
+   if (c != traits_type::eof())
+      pending += (char) c;
+   return traits_type::not_eof(c);
+}
+
+std::streamsize PeepholeBuffer::xsputn(const char *s, std::streamsize n)
+{
+   pending.append(s, n);
+   return n;
+}
+
+//
+// Split the complete lines in `pending' into AsmLines. An instruction is
+// a tab, the opcode, a tab and the operands separated by blanks; a label
+// starts in the first column and ends in a colon. Everything else,
+// including directives, is kept as text.
+//
+void PeepholeBuffer::split_lines()
+{
+   size_t start = 0, end;
+   while ((end = pending.find('\n', start)) != std::string::npos) {
+      AsmLine line;
+      line.text = pending.substr(start, end - start);
+      line.changed = line.deleted = false;
+      line.kind = AsmLine::OTHER;
+      if (line.text.size() > 1 && line.text[0] == '	' && line.text[1] != '.') {
+         size_t op_end = line.text.find('	', 1);
+         line.op = line.text.substr(1, op_end == std::string::npos ? std::string::npos : op_end - 1);
+         if (op_end != std::string::npos) {
+            size_t pos = op_end;
+            while ((pos = line.text.find_first_not_of(" 	", pos)) != std::string::npos) {
+               size_t arg_end = line.text.find_first_of(" 	", pos);
+               line.args.push_back(line.text.substr(pos, arg_end - pos));
+               pos = arg_end;
+            }
+         }
+         line.kind = AsmLine::INSTR;
+      } else if (!line.text.empty() && line.text[0] != '	' && line.text[0] != '#' &&
+                 line.text[line.text.size() - 1] == ':') {
+         line.op = line.text.substr(0, line.text.size() - 1);
+         line.kind = AsmLine::TAG;
+      }
+      lines.push_back(line);
+      start = end + 1;
+   }
+   pending.erase(0, start);
+}
+
+void PeepholeBuffer::flush_output()
+{
+   split_lines();
+   optimize();
+   for (size_t i = 0; i < lines.size(); i++) {
+      AsmLine &line = lines[i];
+      if (line.deleted)
+         continue;
+      if (line.changed) {
+         std::string text = "\t" + line.op + "\t";
+         for (size_t a = 0; a < line.args.size(); a++)
+            text += (a ? " " : "") + line.args[a];
+         out->sputn(text.data(), text.size());
+      } else {
+         out->sputn(line.text.data(), line.text.size());
+      }
+      out->sputc('\n');
+   }
+   lines.clear();
+}
+
+//
+// What an instruction does with registers, as far as the rewrites below
+// need to know. Opcodes not listed are treated as reading every register.
+//
+static bool is_branch(const std::string& op)
+{
+   return op == "b" || op == "beq" || op == "bne" || op == "beqz" || op == "bnez" ||
+          op == "blt" || op == "ble" || op == "bgt" || op == "bge";
+}
+
+static bool writes_first_arg(const std::string& op)
+{
+   return op == "lw" || op == "li" || op == "la" || op == "move" || op == "neg" ||
+          op == "slt" || op == "sltiu" || op == "xor" || op == "xori" ||
+          op == "add" || op == "addu" || op == "addi" || op == "addiu" ||
+          op == "sub" || op == "mul" || op == "div" || op == "sll";
+}
+
+// the base register of an "offset(reg)" operand, or the operand itself
+static std::string base_reg(const std::string& arg)
+{
+   size_t open = arg.find('(');
+   if (open == std::string::npos)
+      return arg;
+   return arg.substr(open + 1, arg.find(')') - open - 1);
+}
+
+static bool reads_reg(const AsmLine& line, const std::string& reg)
+{
+   if (!writes_first_arg(line.op) && line.op != "sw" && !is_branch(line.op) &&
+       line.op != "jal" && line.op != "jalr" && line.op != "jr")
+      return true;
+   size_t first = writes_first_arg(line.op) ? 1 : 0;
+   if (line.op == "lw")
+      return base_reg(line.args[1]) == reg;
+   for (size_t a = first; a < line.args.size(); a++)
+      if (base_reg(line.args[a]) == reg)
+         return true;
+   return false;
+}
+
+static bool is_temp_reg(const std::string& reg)
+{
+   return reg.size() == 3 && reg[0] == '$' && reg[1] == 't';
+}
+
+size_t PeepholeBuffer::next_line(size_t i)
+{
+   for (i++; i < lines.size() && lines[i].deleted; i++)
+      ;
+   return i;
+}
+
+//
+// True if the temporary reg holds no value anyone reads after line i:
+// it is written, or the method returns, before it is read. Labels,
+// directives, branches and calls (runtime routines such as
+// equality_test take arguments in $t1 and $t2) end the search as "live".
+//
+bool PeepholeBuffer::dead_after(size_t i, const std::string& reg)
+{
+   if (!is_temp_reg(reg))
+      return false;
+   for (i = next_line(i); i < lines.size(); i = next_line(i)) {
+      AsmLine &line = lines[i];
+      if (line.kind != AsmLine::INSTR || reads_reg(line, reg))
+         return false;
+      if (line.op == "jr")
+         return true;
+      if (line.op == "jal" || line.op == "jalr" || is_branch(line.op))
+         return false;
+      if (writes_first_arg(line.op) && line.args[0] == reg)
+         return true;
+   }
+   return true;
+}
+
+//
+// Branch threading: a branch to a label whose first instruction is an
+// unconditional branch goes straight to that branch's target, and an
+// unconditional branch to the label right after it is deleted.
+//
+bool PeepholeBuffer::thread_branches()
+{
+   std::unordered_map<std::string, size_t> label_at;
+   for (size_t i = 0; i < lines.size(); i++)
+      if (lines[i].kind == AsmLine::TAG && !lines[i].deleted)
+         label_at[lines[i].op] = i;
+
+   bool progress = false;
+   for (size_t i = 0; i < lines.size(); i++) {
+      AsmLine &line = lines[i];
+      if (line.deleted || line.kind != AsmLine::INSTR || !is_branch(line.op) || line.args.empty())
+         continue;
+      std::string &target = line.args.back();
+      std::set<std::string> seen;
+      std::string final_target = target;
+      bool cycle = false;
+      while (!(cycle = !seen.insert(final_target).second)) {
+         std::unordered_map<std::string, size_t>::iterator at = label_at.find(final_target);
+         if (at == label_at.end())
+            break;
+         size_t j = at->second;
+         while (j < lines.size() && (lines[j].deleted || lines[j].kind == AsmLine::TAG))
+            j++;
+         if (j >= lines.size() || lines[j].kind != AsmLine::INSTR || lines[j].op != "b")
+            break;
+         final_target = lines[j].args.back();
+      }
+      // a chain that loops back on itself is left alone
+      if (!cycle && final_target != target) {
+         target = final_target;
+         line.changed = progress = true;
+      }
+
+      if (line.op == "b") {
+         size_t j = next_line(i);
+         for (; j < lines.size() && lines[j].kind == AsmLine::TAG; j = next_line(j))
+            if (lines[j].op == target) {
+               line.deleted = progress = true;
+               removed++;
+               break;
+            }
+      }
+   }
+   return progress;
+}
+
+//
+// Push/pop cancellation:
+//      sw R 0($sp); addiu $sp $sp -4; ...; lw Q 4($sp); addiu $sp $sp 4
+// becomes "move Q R" when nothing in between touches $sp, calls or
+// branches. The move goes where the lw was if the code in between leaves
+// R alone, or where the sw was if it leaves Q alone.
+//
+bool PeepholeBuffer::cancel_push_pop(size_t i)
+{
+   AsmLine &push = lines[i];
+   if (push.op != "sw" || push.args.size() != 2 || push.args[1] != "0($sp)")
+      return false;
+   size_t adjust = next_line(i);
+   if (adjust >= lines.size() || lines[adjust].kind != AsmLine::INSTR ||
+       lines[adjust].op != "addiu" || lines[adjust].args.size() != 3 ||
+       lines[adjust].args[0] != SP || lines[adjust].args[1] != SP || lines[adjust].args[2] != "-4")
+      return false;
+
+   const std::string reg = push.args[0];
+   bool reg_written = false;
+   std::vector<size_t> between;
+   for (size_t j = next_line(adjust); j < lines.size(); j = next_line(j)) {
+      AsmLine &line = lines[j];
+      if (line.kind != AsmLine::INSTR)
+         return false;
+      if (line.op == "lw" && line.args.size() == 2 && line.args[1] == "4($sp)") {
+         size_t pop = next_line(j);
+         if (pop >= lines.size() || lines[pop].kind != AsmLine::INSTR || lines[pop].op != "addiu" ||
+             lines[pop].args.size() != 3 || lines[pop].args[0] != SP ||
+             lines[pop].args[1] != SP || lines[pop].args[2] != "4")
+            return false;
+         const std::string dest = line.args[0];
+         if (reg_written) {
+            for (size_t k = 0; k < between.size(); k++)
+               if (reads_reg(lines[between[k]], dest) || lines[between[k]].args[0] == dest)
+                  return false;
+            push.op = "move";
+            push.args[1] = reg;
+            push.args[0] = dest;
+            push.changed = line.deleted = true;
+         } else if (dest == reg) {
+            push.deleted = line.deleted = true;
+            removed++;
+         } else {
+            push.deleted = true;
+            line.op = "move";
+            line.args[1] = reg;
+            line.changed = true;
+         }
+         lines[adjust].deleted = lines[pop].deleted = true;
+         removed += 3;
+         return true;
+      }
+      if (!writes_first_arg(line.op) || reads_reg(line, SP) || line.args[0] == SP)
+         return false;
+      reg_written = reg_written || line.args[0] == reg;
+      between.push_back(j);
+   }
+   return false;
+}
+
+//
+// Address folding:
+//      la T R  or  move T R;  addiu T T k    becomes  addiu T R k
+//      addiu T B k;  lw/sw X off(T)          becomes  lw/sw X off+k(B)
+// the second only when T is not read again.
+//
+bool PeepholeBuffer::fold_address(size_t i)
+{
+   AsmLine &first = lines[i];
+   size_t j = next_line(i);
+   if (j >= lines.size() || lines[j].kind != AsmLine::INSTR)
+      return false;
+   AsmLine &second = lines[j];
+
+   if ((first.op == "la" || first.op == "move") && first.args.size() == 2 &&
+       first.args[1][0] == '$' && second.op == "addiu" && second.args.size() == 3 &&
+       second.args[0] == first.args[0] && second.args[1] == first.args[0]) {
+      second.args[1] = first.args[1];
+      second.changed = first.deleted = true;
+      removed++;
+      return true;
+   }
+
+   if (first.op == "addiu" && first.args.size() == 3 && first.args[0] != first.args[1] &&
+       first.args[2].find_first_not_of("-0123456789") == std::string::npos &&
+       (second.op == "lw" || second.op == "sw") && second.args.size() == 2 &&
+       base_reg(second.args[1]) == first.args[0] &&
+       (second.op == "lw" || second.args[0] != first.args[0]) &&
+       (dead_after(j, first.args[0]) || (second.op == "lw" && second.args[0] == first.args[0]))) {
+      int offset = atoi(second.args[1].c_str()) + atoi(first.args[2].c_str());
+      second.args[1] = std::to_string(offset) + "(" + first.args[1] + ")";
+      second.changed = first.deleted = true;
+      removed++;
+      return true;
+   }
+   return false;
+}
+
+//
+// Dead moves: "move R R", and a move into a temporary nobody reads.
+//
+bool PeepholeBuffer::remove_dead_move(size_t i)
+{
+   AsmLine &line = lines[i];
+   if (line.op != "move" || line.args.size() != 2)
+      return false;
+   if (line.args[0] != line.args[1] && !dead_after(i, line.args[0]))
+      return false;
+   line.deleted = true;
+   removed++;
+   return true;
+}
+
+void PeepholeBuffer::optimize()
+{
+   bool progress = true;
+   while (progress) {
+      progress = thread_branches();
+      for (size_t i = 0; i < lines.size(); i++) {
+         if (lines[i].deleted || lines[i].kind != AsmLine::INSTR)
+            continue;
+         if (cancel_push_pop(i) || fold_address(i) || remove_dead_move(i))
+            progress = true;
+      }
+   }
+}
+
+
 ///////////////////////////////////////////////////////////////////////
 //
 // CgenNode methods
@@ -1346,6 +1966,7 @@ CgenNodeP CgenClassTable::root()
 CgenNode::CgenNode(Class_ nd, Basicness bstatus, CgenClassTableP ct) :
    class__class((const class__class &) *nd),
    parentnd(NULL),
+   tag(-1),
    children(NULL),
    basic_status(bstatus)
 { 
@@ -1396,7 +2017,7 @@ void assign_class::code(ostream &s) {
 
   expr->code(s);
   // result is now in the accumulator
-  int offs = cgen_state.classtableptr->get_attribute_offset ( name->get_string() , cgen_state.curr_cgen_node );
+  int offs = cgen_state.classtableptr->get_attribute_offset ( name , cgen_state.curr_cgen_node );
   
   emit_load_address(T1,SELF,s);
   emit_addiu(T1,T1,offs, s);
@@ -1412,6 +2033,55 @@ void static_dispatch_class::code(ostream &s) {
 }
 
 
+/*
+  Inlining. A devirtualized dispatch to a small method of a user class is
+  replaced by the method's body: self is rebound to the receiver, and
+  the formals to the actual arguments, which must all be constants, so
+  they can be substituted for the formals wherever the body reads them
+  (see object_class::code) instead of being pushed. A body that assigns
+  to a formal, or binds a formal's name with let or case, is not inlined,
+  since there the name does not always stand for the argument. A method
+  is never inlined into itself, and inlining nests at most INLINE_DEPTH
+  deep.
+  The largest body inlined, in AST nodes, is COOLC_INLINE_SIZE from the
+  environment (default 8; 0 turns inlining off).
+*/
+static Feature inline_candidate(CgenNodeP target, Symbol name, Expressions actual)
+{
+  if (target == NULL || target->basic() || !cgen_state.can_inline())
+    return NULL;
+  for(int i = actual->first(); actual->more(i); i = actual->next(i))
+  {
+    int value;
+    if (!actual->nth(i)->fold(value))
+      return NULL;
+  }
+
+  Features feats = target->get_features();
+  for(int i = feats->first(); feats->more(i); i = feats->next(i))
+  {
+    Feature feat = feats->nth(i);
+    if (feat->feat_is_method() && feat->get_feature_name() == name)
+      return cgen_state.can_inline(feat) ? feat : NULL;
+  }
+  return NULL;
+}
+
+// the receiver is in ACC and is not void
+static void code_inlined(CgenNodeP target, Feature method, Expressions actual, ostream &s)
+{
+  CgenNodeP caller = cgen_state.curr_cgen_node;
+  emit_push(SELF, s);
+  emit_move(SELF, ACC, s);
+  cgen_state.curr_cgen_node = target;
+  cgen_state.begin_inline(method, actual);
+  method->get_feat_expr()->code(s);
+  cgen_state.end_inline();
+  cgen_state.curr_cgen_node = caller;
+  emit_pop(SELF, s);
+}
+
+
 // /* 
 //   A FUNCTION CALL! ON THE CALLER SIDE
 //   - 4*n + 4 arguments in the activation record
@@ -1419,9 +2089,26 @@ void static_dispatch_class::code(ostream &s) {
 // */
 void dispatch_class::code(ostream &s)
 { 
+  Symbol class_param;
+  if(expr->get_type() == SELF_TYPE){
+
+      class_param = cgen_state.curr_cgen_node->get_name(); 
+
+  }else{
+
+    class_param = expr->get_type();
+  }
+  int offs = cgen_state.classtableptr->get_method_offset ( name /*method name*/, class_param );
+  // with -O, call the method directly if no subclass can override it
+  CgenNodeP target = cgen_optimize ?
+    cgen_state.classtableptr->get_unique_target ( name, class_param ) : NULL;
+  cgen_state.count_dispatch(target != NULL);
+  // or, if it is small enough, code its body here (see code_inlined)
+  Feature method = inline_candidate(target, name, actual);
+
   // Generate code for all of the arguemnts
   // save the actual parameters in reverse order
-  for(int i = actual->first(); actual->more(i); i = actual->next(i))
+  for(int i = actual->first(); method == NULL && actual->more(i); i = actual->next(i))
   {
     actual->nth(i)->code(s);
     // for each of the arguments
@@ -1440,17 +2127,6 @@ void dispatch_class::code(ostream &s)
   // MAKE SURE THE XPRESSION DID NOT RETURN NUL
 
   // ALSO CHECK FOR ONE OF THE 3 RUNTIME ERRORS
-  std::string class_param;
-  if(expr->get_type() == SELF_TYPE){
-
-      class_param = cgen_state.curr_cgen_node->get_name()->get_string(); 
-
-  }else{
-
-    class_param = expr->get_type()->get_string();
-  }
-  int offs = cgen_state.classtableptr->get_method_offset ( name->get_string() /*method name*/, class_param );
-  
   int label_id = cgen_state.increment_label_cntr();
   
   emit_bne( ACC, ZERO,label_id, s);
@@ -1461,6 +2137,14 @@ void dispatch_class::code(ostream &s)
 
 
   // SELF/OBJECT will already be in the accumulator
+  if (method != NULL) {
+    code_inlined(target, method, actual, s);
+    return;
+  }
+  if (target != NULL) {
+    s << JAL; emit_method_ref(target->get_name(), name, s); s << endl;
+    return;
+  }
   emit_load(T1 /*dst */, 2 /*offs*/, ACC /*src*/, s);
   emit_load(T1 , offs, T1, s); // WALK ALONG THE DISPATCH TABLE UNTIL YOU FIND WHAT YOU WANT
   emit_jalr(T1, s);
@@ -1498,7 +2182,12 @@ void method_class::code(ostream &s) {
   //{
   //  cgen_state.symtab->addid( formals->nth(i)->get_name(), formals->nth(i)->get_type_decl() );
   //}
+  cgen_state.enter_method(this);
   expr->code(s);
+  cgen_state.exit_method();
+  if (cgen_state.counts_allocs() && name == main_meth &&
+      cgen_state.curr_cgen_node->get_name() == Main)
+    emit_print_alloc_count(s);
   // now, after the body has been executed, we restore the environment
   restore_stack_after_call(s);
   //cgen_state.symtab->exitscope();
@@ -1650,85 +2339,168 @@ void let_class::code(ostream &s) {
 
 }
 
-/*
-  ACC is the accumulator
-  SP is the stack pointer
-  T1 is the Temporary 1 register
-*/
-void plus_class::code(ostream &s) {
-  e1->code(s);
-  // result now stored in accumulator
-  emit_store( ACC /* char *source_reg */, 0 /* offset */, SP /* char *dest_reg */, s);
-  emit_addiu( SP /* dest */, SP /* src1 */, -4 /* imm */, s );
-  e2->code(s);
-  // result now stored in acculumator
-  emit_load( T1 /* char *dest_reg */, 4 /* offset */, SP /* char *source_reg */, s);
-  emit_add( ACC /*char *dest $a0 */, T1 /* $t1 */, ACC /* char *src2 $a0 */, s);
-  emit_addiu ( SP, SP, 4, s );
+//******************************************************************
+//
+//   Unboxed arithmetic
+//
+//   Inside an arithmetic or comparison expression Int and Bool values
+//   are kept as raw words: code_unboxed leaves the integer, or 0/1 for a
+//   Bool, in ACC. A result is boxed only where it escapes, which is
+//   wherever code() is called on it: as a dispatch argument, an assigned
+//   value, a method's result. A Bool is boxed as one of the two Bool
+//   constants; an Int becomes a new Int object. Subtrees whose value is
+//   known at compile time (fold) are coded as an immediate, or as an Int
+//   constant when boxed.
+//
+//*****************************************************************
+
+static bool unboxed_type(Expression e)
+{
+  return e->get_type() == Int || e->get_type() == Bool;
 }
 
-/*
-  Subtraction code is identical to the code for addition, except we use the "sub" instruction
-  instead of the "add" instruction in the penultimate line. Only the actual operation 
-  is different
+// An expression of any other kind is evaluated and its value read from
+// the object.
+void Expression_class::code_unboxed(ostream &s)
+{
+  int value;
+  if (fold(value)) {
+    emit_load_imm(ACC, value, s);
+    return;
+  }
+  code(s);
+  emit_fetch_int(ACC, ACC, s);
+}
 
-  SP is stack pointer
-  ACC is accumulator
-  T1 is Temporary 1 register
-*/
-void sub_class::code(ostream &s) {
-  e1->code(s);
-  // result now stored in accumulator
-  emit_store( ACC /* char *source_reg */, 0 /* offset */, SP /* char *dest_reg */, s);
-  emit_addiu( SP /* dest */, SP /* src1 */, -4 /* imm */, s );
-  e2->code(s);
-  // result now stored in acculumator
-  emit_load( T1 /* char *dest_reg */, 4 /* offset */, SP /* char *source_reg */, s);
-  emit_sub( ACC /*char *dest $a0 */, T1 /* $t1 */, ACC /* char *src2 $a0 */, s);
-  emit_addiu ( SP, SP, 4, s );
-}
-
-void mul_class::code(ostream &s) {
-  e1->code(s);
-  // result now stored in accumulator
-  emit_store( ACC /* char *source_reg */, 0 /* offset */, SP /* char *dest_reg */, s);
-  emit_addiu( SP /* dest */, SP /* src1 */, -4 /* imm */, s );
-  e2->code(s);
-  // result now stored in acculumator
-  emit_load( T1 /* char *dest_reg */, 4 /* offset */, SP /* char *source_reg */, s);
-  emit_mul( ACC /*char *dest $a0 */, T1 /* $t1 */, ACC /* char *src2 $a0 */, s);
-  emit_addiu ( SP, SP, 4, s );
-}
-
-void divide_class::code(ostream &s) {
-  e1->code(s);
-  // result now stored in accumulator
-  emit_store( ACC /* char *source_reg */, 0 /* offset */, SP /* char *dest_reg */, s);
-  emit_addiu( SP /* dest */, SP /* src1 */, -4 /* imm */, s );
-  e2->code(s);
-  // result now stored in acculumator
-  emit_load( T1 /* char *dest_reg */, 4 /* offset */, SP /* char *source_reg */, s);
-  emit_div( ACC /*char *dest $a0 */, T1 /* $t1 */, ACC /* char *src2 $a0 */, s);
-  emit_addiu ( SP, SP, 4, s );
+// Codes e as an immediate if it is constant.
+static bool code_folded(Expression e, ostream &s)
+{
+  int value;
+  if (!e->fold(value))
+    return false;
+  cgen_state.count_fold();
+  emit_load_imm(ACC, value, s);
+  return true;
 }
 
 /*
- Load -1 into the register T1, and then multiply by -1.
+  Boxes the value of the Int expression e. The object is allocated
+  first, so that while e is evaluated only a pointer waits on the stack:
+  the collector takes any word on the stack that looks like a heap
+  address for an object.
 */
-void neg_class::code(ostream &s) {
-  e1->code(s);
-  emit_load_imm(T1, -1, s);
-  emit_mul(ACC, T1, ACC, s);
+static void code_boxed_int(Expression e, ostream &s)
+{
+  int value;
+  if (e->fold(value)) {
+    cgen_state.count_fold();
+    emit_load_int(ACC, inttable.add_int(value), s);     // see add_constants
+    return;
+  }
+  cgen_state.count_box();
+  emit_partial_load_address(ACC, s); emit_protobj_ref(Int, s); s << endl;
+  emit_jal("Object.copy", s);
+  emit_count_alloc(s);
+  emit_push(ACC, s);
+  e->code_unboxed(s);
+  emit_pop(T1, s);
+  emit_store_int(ACC, T1, s);
+  emit_move(ACC, T1, s);
 }
 
-/*
-blt
-*/
-void lt_class::code(ostream &s) {
+static void code_boxed_bool(Expression e, ostream &s)
+{
+  int value;
+  if (e->fold(value)) {
+    cgen_state.count_fold();
+    emit_load_bool(ACC, BoolConst(value), s);
+    return;
+  }
+  e->code_unboxed(s);
+  int done = cgen_state.increment_label_cntr();
+  emit_move(T1, ACC, s);
+  emit_load_bool(ACC, truebool, s);
+  emit_bne(T1, ZERO, done, s);
+  emit_load_bool(ACC, falsebool, s);
+  emit_label_def(done, s);
+}
+
+// a folded result that fits in a word
+static bool fold_result(long long result, int &value)
+{
+  if (result < INT_MIN || result > INT_MAX)
+    return false;
+  value = (int) result;
+  return true;
+}
 
+typedef void (*arith_emitter)(char *dest, char *src1, char *src2, ostream& s);
 
+static void emit_less_eq(char *dest, char *src1, char *src2, ostream& s)
+{
+  emit_slt(dest, src2, src1, s);
+  emit_xori(dest, dest, 1, s);
+}
+
+static void emit_equal(char *dest, char *src1, char *src2, ostream& s)
+{
+  emit_xor(dest, src1, src2, s);
+  emit_sltiu(dest, dest, 1, s);
 }
 
+/*
+  e1 op e2 on unboxed values, evaluated left to right into ACC.
+
+  A constant operand is loaded into T1 after the other one is evaluated.
+  Otherwise, while e2 is evaluated the value of e1 waits in a temporary
+  register if e2 makes no call and needs fewer temporaries than are free
+  (its Sethi-Ullman number, see temps_needed), and on the stack if not
+  or with -r. Across a call it waits boxed, because of the collector
+  (see code_boxed_int).
+*/
+static void code_arith(Expression e1, Expression e2, arith_emitter op, ostream &s)
+{
+  int value;
+  if (e1->fold(value)) {
+    e2->code_unboxed(s);
+    emit_load_imm(T1, value, s);
+    op(ACC, T1, ACC, s);
+  } else if (e2->fold(value)) {
+    e1->code_unboxed(s);
+    emit_load_imm(T1, value, s);
+    op(ACC, ACC, T1, s);
+  } else if (e2->get_temps_needed() >= MAKES_CALL) {
+    e1->code(s);
+    emit_push(ACC, s);
+    e2->code_unboxed(s);
+    emit_pop(T1, s);
+    emit_fetch_int(T1, T1, s);
+    op(ACC, T1, ACC, s);
+  } else if (!disable_reg_alloc && e2->get_temps_needed() < cgen_state.free_temps()) {
+    e1->code_unboxed(s);
+    char *left = cgen_state.alloc_temp();
+    emit_move(left, ACC, s);
+    e2->code_unboxed(s);
+    op(ACC, left, ACC, s);
+    cgen_state.release_temp();
+  } else {
+    e1->code_unboxed(s);
+    emit_push(ACC, s);
+    e2->code_unboxed(s);
+    emit_pop(T1, s);
+    op(ACC, T1, ACC, s);
+  }
+}
+
+void plus_class::code(ostream &s) { code_boxed_int(this, s); }
+void sub_class::code(ostream &s) { code_boxed_int(this, s); }
+void mul_class::code(ostream &s) { code_boxed_int(this, s); }
+void divide_class::code(ostream &s) { code_boxed_int(this, s); }
+void neg_class::code(ostream &s) { code_boxed_int(this, s); }
+void lt_class::code(ostream &s) { code_boxed_bool(this, s); }
+void leq_class::code(ostream &s) { code_boxed_bool(this, s); }
+void comp_class::code(ostream &s) { code_boxed_bool(this, s); }
+
 /*
 beq if equal
 
@@ -1736,24 +2508,127 @@ USE THE BUILT IN RUNTIME TEST FROM COOL RUNTIME
 
 COPY THE REFERENCE COMPILER SOLUTION equality_test
 
+Ints and Bools are compared by value, unboxed.
 */
 void eq_class::code(ostream &s) {
+  if (unboxed_type(e1) && unboxed_type(e2))
+    code_boxed_bool(this, s);
+}
 
+void plus_class::code_unboxed(ostream &s) {
+  if (!code_folded(this, s)) code_arith(e1, e2, emit_add, s);
+}
 
+/*
+  Subtraction code is identical to the code for addition, except we use the "sub" instruction
+  instead of the "add" instruction in the penultimate line. Only the actual operation 
+  is different
+*/
+void sub_class::code_unboxed(ostream &s) {
+  if (!code_folded(this, s)) code_arith(e1, e2, emit_sub, s);
 }
 
+void mul_class::code_unboxed(ostream &s) {
+  if (!code_folded(this, s)) code_arith(e1, e2, emit_mul, s);
+}
 
+void divide_class::code_unboxed(ostream &s) {
+  if (!code_folded(this, s)) code_arith(e1, e2, emit_div, s);
+}
 
-void leq_class::code(ostream &s) {
+void neg_class::code_unboxed(ostream &s) {
+  if (code_folded(this, s)) return;
+  e1->code_unboxed(s);
+  emit_neg(ACC, ACC, s);
+}
 
+void lt_class::code_unboxed(ostream &s) {
+  if (!code_folded(this, s)) code_arith(e1, e2, emit_slt, s);
+}
 
+void leq_class::code_unboxed(ostream &s) {
+  if (!code_folded(this, s)) code_arith(e1, e2, emit_less_eq, s);
 }
 
+void eq_class::code_unboxed(ostream &s) {
+  if (!unboxed_type(e1) || !unboxed_type(e2))
+    Expression_class::code_unboxed(s);
+  else if (!code_folded(this, s))
+    code_arith(e1, e2, emit_equal, s);
+}
+
+void comp_class::code_unboxed(ostream &s) {
+  if (code_folded(this, s)) return;
+  e1->code_unboxed(s);
+  emit_xori(ACC, ACC, 1, s);
+}
+
+//
+// Constant folding. Division by zero and results that overflow are left
+// to run time. fold() keeps the result on the node, as get_temps_needed
+// does, so asking again at every level of a chain costs nothing.
+//
+bool plus_class::constant_value(int &value) {
+  int a, b;
+  return e1->fold(a) && e2->fold(b) && fold_result((long long) a + b, value);
+}
 
+bool sub_class::constant_value(int &value) {
+  int a, b;
+  return e1->fold(a) && e2->fold(b) && fold_result((long long) a - b, value);
+}
 
-void comp_class::code(ostream &s) {
+bool mul_class::constant_value(int &value) {
+  int a, b;
+  return e1->fold(a) && e2->fold(b) && fold_result((long long) a * b, value);
+}
 
+bool divide_class::constant_value(int &value) {
+  int a, b;
+  return e1->fold(a) && e2->fold(b) && b != 0 && fold_result((long long) a / b, value);
+}
 
+bool neg_class::constant_value(int &value) {
+  int a;
+  return e1->fold(a) && fold_result(-(long long) a, value);
+}
+
+bool lt_class::constant_value(int &value) {
+  int a, b;
+  if (!e1->fold(a) || !e2->fold(b)) return false;
+  value = a < b;
+  return true;
+}
+
+bool leq_class::constant_value(int &value) {
+  int a, b;
+  if (!e1->fold(a) || !e2->fold(b)) return false;
+  value = a <= b;
+  return true;
+}
+
+bool eq_class::constant_value(int &value) {
+  int a, b;
+  if (!unboxed_type(e1) || !unboxed_type(e2) || !e1->fold(a) || !e2->fold(b)) return false;
+  value = a == b;
+  return true;
+}
+
+bool comp_class::constant_value(int &value) {
+  int a;
+  if (!e1->fold(a)) return false;
+  value = !a;
+  return true;
+}
+
+bool int_const_class::constant_value(int &value) {
+  value = (int) strtoul(token->get_string(), NULL, 10);
+  return true;
+}
+
+bool bool_const_class::constant_value(int &value) {
+  value = val;
+  return true;
 }
 
 void int_const_class::code(ostream& s)  
@@ -1795,6 +2670,7 @@ void new__class::code(ostream &s) {
   strcat( classname_buf, protobj_buf);
   emit_load_address( ACC, classname_buf , s);
   emit_jal( "Object.copy", s);
+  emit_count_alloc(s);
 
   // allocate n new locations to hold all n attribtues of an object (enough space for every attribute)
   // Form the new object
@@ -1852,8 +2728,268 @@ void no_expr_class::code(ostream &s) {
   looking up a variable does not affect the store
 */
 void object_class::code(ostream &s) {
-  int offs = cgen_state.classtableptr->get_attribute_offset ( name->get_string() , cgen_state.curr_cgen_node );
+  Expression arg = cgen_state.inline_arg(name);
+  if (arg != NULL) {
+    arg->code(s);
+    return;
+  }
+  int offs = cgen_state.classtableptr->get_attribute_offset ( name , cgen_state.curr_cgen_node );
   emit_load(ACC, offs, SELF, s);
 }
 
 
+//******************************************************************
+//
+//   Sethi-Ullman numbers: how many temporary registers code() needs to
+//   evaluate an expression, or MAKES_CALL if it calls a method or the
+//   runtime, which may overwrite every temporary. An arithmetic node
+//   holds its left operand in a temporary while its right operand is
+//   evaluated, so it needs one more than its right operand. For an Int
+//   or Bool expression this counts code_unboxed; where code() is called
+//   on a subexpression instead, an Int result may be boxed, and boxing
+//   calls Object.copy (boxed_temps).
+//
+//*****************************************************************
+
+static int arith_temps(Expression e1, Expression e2)
+{
+  int value;
+  if (e1->fold(value))
+    return e2->get_temps_needed();
+  if (e2->fold(value))
+    return e1->get_temps_needed();
+  return std::max(e1->get_temps_needed(), e2->get_temps_needed() + 1);
+}
+
+static int boxed_temps(Expression e)
+{
+  int value;
+  if (e->get_type() == Int && !e->fold(value))
+    return MAKES_CALL;
+  return e->get_temps_needed();
+}
+
+int assign_class::temps_needed() { return boxed_temps(expr); }
+int static_dispatch_class::temps_needed() { return MAKES_CALL; }
+int dispatch_class::temps_needed() { return MAKES_CALL; }
+
+int cond_class::temps_needed()
+{
+  return std::max(pred->get_temps_needed(),
+                  std::max(boxed_temps(then_exp), boxed_temps(else_exp)));
+}
+
+int loop_class::temps_needed()
+{
+  return std::max(pred->get_temps_needed(), boxed_temps(body));
+}
+
+// a case on void, or with no matching branch, calls the runtime
+int typcase_class::temps_needed() { return MAKES_CALL; }
+
+int block_class::temps_needed()
+{
+  int temps = 0;
+  for(int i = body->first(); body->more(i); i = body->next(i))
+    temps = std::max(temps, boxed_temps(body->nth(i)));
+  return temps;
+}
+
+int let_class::temps_needed()
+{
+  return std::max(boxed_temps(init), boxed_temps(body));
+}
+
+int plus_class::temps_needed() { return arith_temps(e1, e2); }
+int sub_class::temps_needed() { return arith_temps(e1, e2); }
+int mul_class::temps_needed() { return arith_temps(e1, e2); }
+int divide_class::temps_needed() { return arith_temps(e1, e2); }
+int neg_class::temps_needed() { return e1->get_temps_needed(); }
+int lt_class::temps_needed() { return arith_temps(e1, e2); }
+// equality of objects is decided by the runtime's equality_test
+int eq_class::temps_needed()
+{
+  if (unboxed_type(e1) && unboxed_type(e2))
+    return arith_temps(e1, e2);
+  return MAKES_CALL;
+}
+int leq_class::temps_needed() { return arith_temps(e1, e2); }
+int comp_class::temps_needed() { return e1->get_temps_needed(); }
+int int_const_class::temps_needed() { return 0; }
+int string_const_class::temps_needed() { return 0; }
+int bool_const_class::temps_needed() { return 0; }
+int new__class::temps_needed() { return MAKES_CALL; }
+int isvoid_class::temps_needed() { return boxed_temps(e1); }
+int no_expr_class::temps_needed() { return 0; }
+int object_class::temps_needed() { return 0; }
+
+
+//******************************************************************
+//
+//   Size of an expression in AST nodes, which decides what is small
+//   enough to inline.
+//
+//*****************************************************************
+
+static int exprs_size(Expressions exprs)
+{
+  int size = 0;
+  for(int i = exprs->first(); exprs->more(i); i = exprs->next(i))
+    size += exprs->nth(i)->tree_size();
+  return size;
+}
+
+int assign_class::tree_size() { return 1 + expr->tree_size(); }
+int static_dispatch_class::tree_size() { return 1 + expr->tree_size() + exprs_size(actual); }
+int dispatch_class::tree_size() { return 1 + expr->tree_size() + exprs_size(actual); }
+int cond_class::tree_size() { return 1 + pred->tree_size() + then_exp->tree_size() + else_exp->tree_size(); }
+int loop_class::tree_size() { return 1 + pred->tree_size() + body->tree_size(); }
+
+int typcase_class::tree_size()
+{
+  int size = 1 + expr->tree_size();
+  for(int i = cases->first(); cases->more(i); i = cases->next(i))
+    size += 1 + cases->nth(i)->get_expr()->tree_size();
+  return size;
+}
+
+int block_class::tree_size() { return 1 + exprs_size(body); }
+int let_class::tree_size() { return 1 + init->tree_size() + body->tree_size(); }
+int plus_class::tree_size() { return 1 + e1->tree_size() + e2->tree_size(); }
+int sub_class::tree_size() { return 1 + e1->tree_size() + e2->tree_size(); }
+int mul_class::tree_size() { return 1 + e1->tree_size() + e2->tree_size(); }
+int divide_class::tree_size() { return 1 + e1->tree_size() + e2->tree_size(); }
+int neg_class::tree_size() { return 1 + e1->tree_size(); }
+int lt_class::tree_size() { return 1 + e1->tree_size() + e2->tree_size(); }
+int eq_class::tree_size() { return 1 + e1->tree_size() + e2->tree_size(); }
+int leq_class::tree_size() { return 1 + e1->tree_size() + e2->tree_size(); }
+int comp_class::tree_size() { return 1 + e1->tree_size(); }
+int int_const_class::tree_size() { return 1; }
+int string_const_class::tree_size() { return 1; }
+int bool_const_class::tree_size() { return 1; }
+int new__class::tree_size() { return 1; }
+int isvoid_class::tree_size() { return 1 + e1->tree_size(); }
+int no_expr_class::tree_size() { return 0; }
+int object_class::tree_size() { return 1; }
+
+
+//******************************************************************
+//
+//   Whether an expression assigns to one of a method's formals, or
+//   binds its name again with let or case. The inliner substitutes the
+//   constant argument for every use of a formal's name, which is only
+//   right when the name means the formal throughout the body and the
+//   formal keeps its value.
+//
+//*****************************************************************
+
+static bool is_formal(Formals formals, Symbol name)
+{
+  for(int i = formals->first(); formals->more(i); i = formals->next(i))
+    if (formals->nth(i)->get_name() == name)
+      return true;
+  return false;
+}
+
+static bool exprs_rebind(Expressions exprs, Formals formals)
+{
+  for(int i = exprs->first(); exprs->more(i); i = exprs->next(i))
+    if (exprs->nth(i)->rebinds(formals))
+      return true;
+  return false;
+}
+
+bool assign_class::rebinds(Formals f) { return is_formal(f, name) || expr->rebinds(f); }
+bool static_dispatch_class::rebinds(Formals f) { return expr->rebinds(f) || exprs_rebind(actual, f); }
+bool dispatch_class::rebinds(Formals f) { return expr->rebinds(f) || exprs_rebind(actual, f); }
+bool cond_class::rebinds(Formals f) { return pred->rebinds(f) || then_exp->rebinds(f) || else_exp->rebinds(f); }
+bool loop_class::rebinds(Formals f) { return pred->rebinds(f) || body->rebinds(f); }
+
+bool typcase_class::rebinds(Formals f)
+{
+  if (expr->rebinds(f))
+    return true;
+  for(int i = cases->first(); cases->more(i); i = cases->next(i))
+    if (is_formal(f, cases->nth(i)->get_name()) || cases->nth(i)->get_expr()->rebinds(f))
+      return true;
+  return false;
+}
+
+bool block_class::rebinds(Formals f) { return exprs_rebind(body, f); }
+bool let_class::rebinds(Formals f) { return is_formal(f, identifier) || init->rebinds(f) || body->rebinds(f); }
+bool plus_class::rebinds(Formals f) { return e1->rebinds(f) || e2->rebinds(f); }
+bool sub_class::rebinds(Formals f) { return e1->rebinds(f) || e2->rebinds(f); }
+bool mul_class::rebinds(Formals f) { return e1->rebinds(f) || e2->rebinds(f); }
+bool divide_class::rebinds(Formals f) { return e1->rebinds(f) || e2->rebinds(f); }
+bool neg_class::rebinds(Formals f) { return e1->rebinds(f); }
+bool lt_class::rebinds(Formals f) { return e1->rebinds(f) || e2->rebinds(f); }
+bool eq_class::rebinds(Formals f) { return e1->rebinds(f) || e2->rebinds(f); }
+bool leq_class::rebinds(Formals f) { return e1->rebinds(f) || e2->rebinds(f); }
+bool comp_class::rebinds(Formals f) { return e1->rebinds(f); }
+bool int_const_class::rebinds(Formals f) { return false; }
+bool string_const_class::rebinds(Formals f) { return false; }
+bool bool_const_class::rebinds(Formals f) { return false; }
+bool new__class::rebinds(Formals f) { return false; }
+bool isvoid_class::rebinds(Formals f) { return e1->rebinds(f); }
+bool no_expr_class::rebinds(Formals f) { return false; }
+bool object_class::rebinds(Formals f) { return false; }
+
+
+//******************************************************************
+//
+//   Int constants from folding. The Int constants are emitted before
+//   any code, so code_constants first walks every method and attribute
+//   initializer and enters the value of each constant Int arithmetic
+//   subtree into inttable, for code_boxed_int to refer to.
+//
+//*****************************************************************
+
+static void exprs_add_constants(Expressions exprs)
+{
+  for(int i = exprs->first(); exprs->more(i); i = exprs->next(i))
+    exprs->nth(i)->add_constants();
+}
+
+// an Int operator: its value if it is constant, else its operands'
+static void arith_add_constants(Expression e, Expression e1, Expression e2)
+{
+  int value;
+  if (e->fold(value)) {
+    inttable.add_int(value);
+    return;
+  }
+  e1->add_constants();
+  if (e2 != NULL) e2->add_constants();
+}
+
+void assign_class::add_constants() { expr->add_constants(); }
+void static_dispatch_class::add_constants() { expr->add_constants(); exprs_add_constants(actual); }
+void dispatch_class::add_constants() { expr->add_constants(); exprs_add_constants(actual); }
+void cond_class::add_constants() { pred->add_constants(); then_exp->add_constants(); else_exp->add_constants(); }
+void loop_class::add_constants() { pred->add_constants(); body->add_constants(); }
+
+void typcase_class::add_constants()
+{
+  expr->add_constants();
+  for(int i = cases->first(); cases->more(i); i = cases->next(i))
+    cases->nth(i)->get_expr()->add_constants();
+}
+
+void block_class::add_constants() { exprs_add_constants(body); }
+void let_class::add_constants() { init->add_constants(); body->add_constants(); }
+void plus_class::add_constants() { arith_add_constants(this, e1, e2); }
+void sub_class::add_constants() { arith_add_constants(this, e1, e2); }
+void mul_class::add_constants() { arith_add_constants(this, e1, e2); }
+void divide_class::add_constants() { arith_add_constants(this, e1, e2); }
+void neg_class::add_constants() { arith_add_constants(this, e1, NULL); }
+void lt_class::add_constants() { e1->add_constants(); e2->add_constants(); }
+void eq_class::add_constants() { e1->add_constants(); e2->add_constants(); }
+void leq_class::add_constants() { e1->add_constants(); e2->add_constants(); }
+void comp_class::add_constants() { e1->add_constants(); }
+void int_const_class::add_constants() { }
+void string_const_class::add_constants() { }
+void bool_const_class::add_constants() { }
+void new__class::add_constants() { }
+void isvoid_class::add_constants() { e1->add_constants(); }
+void no_expr_class::add_constants() { }
+void object_class::add_constants() { }
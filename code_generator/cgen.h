@@ -4,6 +4,10 @@
 #include "cool-tree.h"
 #include "symtab.h"
 #include <map>
+#include <vector>
+#include <unordered_map>
+#include <streambuf>
+#include <string>
 
 
 enum Basicness     {Basic, NotBasic};
@@ -16,15 +20,103 @@ typedef CgenClassTable *CgenClassTableP;
 class CgenNode;
 typedef CgenNode *CgenNodeP;
 
+// Dispatch table layout of a single class, computed once after
+// `traverse' so that dispatch codegen never has to search for a method.
+struct DispatchLayout {
+   std::vector<Symbol> slot_names;                // method name in each slot
+   std::vector<CgenNodeP> slot_owners;            // class that defines it
+   std::vector<CgenNodeP> unique_owners;          // ... in every subclass too, or NULL
+   std::unordered_map<Symbol, int> slot_index;    // method name -> slot
+};
+
+// Object layout of a single class: inherited attributes first, in the
+// same slots as in the parent, followed by the class's own attributes.
+struct AttrLayout {
+   std::vector<Feature> attrs;                    // attribute in each slot
+   std::unordered_map<Symbol, int> offset;        // attribute name -> word offset
+};
+
+//
+// AsmBuffer collects the generated assembly in memory and hands it to the
+// real output stream in a few large writes. `endl' on a stream built on
+// an AsmBuffer does not flush; only flush_output() (or the buffer filling
+// up to FLUSH_LIMIT bytes) writes to the output.
+//
+class AsmBuffer : public std::streambuf {
+private:
+   ostream& out;
+   std::vector<char> buf;
+   long bytes;                                // bytes handed to `out'
+   int flushes;                               // writes to `out'
+   double flush_seconds;                      // time spent in those writes
+protected:
+   int overflow(int c);
+   int sync() { return 0; }
+public:
+   enum { INITIAL_SIZE = 1 << 16, FLUSH_LIMIT = 1 << 24 };
+   AsmBuffer(ostream& o);
+   void flush_output();
+   long get_bytes() { return bytes; }
+   int get_flushes() { return flushes; }
+   double get_flush_seconds() { return flush_seconds; }
+};
+
+// One line of assembly held by a PeepholeBuffer.
+struct AsmLine {
+   enum Kind { INSTR, TAG, OTHER };           // TAG is a label; emit.h has LABEL
+   Kind kind;
+   std::string text;                          // as emitted, without the newline
+   std::string op;                            // opcode, or the label's name
+   std::vector<std::string> args;             // operands of an instruction
+   bool changed;                              // rewritten: print op and args
+   bool deleted;
+};
+
+//
+// PeepholeBuffer sits between the emit_* helpers and an AsmBuffer when
+// the code generator optimizes (-O). It keeps the assembly as a list of
+// parsed lines until flush_output(), then rewrites redundant sequences
+// (see optimize) and passes the result on. Labels, directives and data
+// are kept as they are.
+//
+class PeepholeBuffer : public std::streambuf {
+private:
+   std::streambuf *out;
+   std::string pending;                       // text not yet split into lines
+   std::vector<AsmLine> lines;
+   int removed;                               // instructions deleted so far
+
+   void split_lines();
+   void optimize();
+   bool thread_branches();
+   bool cancel_push_pop(size_t i);
+   bool fold_address(size_t i);
+   bool remove_dead_move(size_t i);
+   size_t next_line(size_t i);
+   bool dead_after(size_t i, const std::string& reg);
+protected:
+   int overflow(int c);
+   std::streamsize xsputn(const char *s, std::streamsize n);
+   int sync() { return 0; }
+public:
+   PeepholeBuffer(std::streambuf *o);
+   void flush_output();
+   int get_removed() { return removed; }
+};
+
 class CgenClassTable : public SymbolTable<Symbol,CgenNode> {
 private:
    List<CgenNode> *nds;
+   AsmBuffer asm_buf;                         // all emit_* output lands here
+   PeepholeBuffer peephole;                   // in front of asm_buf with -O
+   ostream asm_out;
    ostream& str;
    int stringclasstag;
    int intclasstag;
    int boolclasstag;
 
 
+
 // The following methods emit code for
 // constants and global declarations.
 
@@ -45,6 +137,14 @@ private:
    void build_inheritance_tree();
    void set_relations(CgenNodeP nd);
    void traverse(CgenNodeP nd);
+   void build_dispatch_layouts();
+   void build_dispatch_layout(CgenNodeP nd);
+   void find_unique_targets(CgenNodeP nd);
+
+// Dense per-class tables indexed by class tag.
+   std::vector<DispatchLayout> dispatch_layouts;
+   std::vector<AttrLayout> attr_layouts;
+   std::unordered_map<Symbol, int> tag_of_class;
 public:
    CgenClassTable(Classes, ostream& str);
    std::map<CgenNodeP, Features> features_map;
@@ -55,8 +155,9 @@ public:
    void print_class_name_tab();
    void print_dispatch_tables();
    void print_methods();
-int get_attribute_offset (std::string attribute, CgenNodeP nd);
-int get_method_offset (std::string method_name, std::string node_name);
+int get_attribute_offset (Symbol attribute, CgenNodeP nd);
+int get_method_offset (Symbol method_name, Symbol class_name);
+   CgenNodeP get_unique_target(Symbol method_name, Symbol class_name);
    void print_class_obj_tab();
 
    void print_class_init_code(bool is_object_init, CgenNodeP nd);
@@ -70,6 +171,7 @@ int get_method_offset (std::string method_name, std::string node_name);
 class CgenNode : public class__class {
 private: 
    CgenNodeP parentnd;                        // Parent of class
+   int tag;                                   // Class tag, set by traverse
    List<CgenNode> *children;                  // Children of class
    Basicness basic_status;                    // `Basic' if class is basic
                                               // `NotBasic' otherwise
@@ -85,6 +187,8 @@ public:
    List<CgenNode> *get_children() { return children; }
    void set_parentnd(CgenNodeP p);
    CgenNodeP get_parentnd() { return parentnd; }
+   void set_tag(int t) { tag = t; }
+   int get_tag() { return tag; }
    int basic() { return (basic_status == Basic); }
    std::map<std::string, CgenNodeP> method_map; 
 
@@ -54,6 +54,13 @@ public:
     virtual Symbol get_type_decl() = 0;
     virtual Expression get_feat_expr() = 0;
     virtual void code(ostream&) = 0;
+
+    // used by the semantic checker
+    virtual Symbol get_name() = 0;
+    virtual std::vector<Symbol> get_params_and_rt() = 0;
+    virtual Expression get_expression_to_check() = 0;
+    virtual Symbol get_return_type() = 0;
+    virtual Formals get_formals() = 0;
 #ifdef Feature_EXTRAS
    Feature_EXTRAS
 #endif
@@ -83,6 +90,7 @@ class Expression_class : public tree_node {
 public:
    tree_node *copy()		 { return copy_Expression(); }
    virtual Expression copy_Expression() = 0;
+   virtual Symbol type_check(	SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol) = 0;
 
 #ifdef Expression_EXTRAS
    Expression_EXTRAS
@@ -97,6 +105,9 @@ class Case_class : public tree_node {
 public:
    tree_node *copy()		 { return copy_Case(); }
    virtual Case copy_Case() = 0;
+   virtual Symbol get_type_decl() = 0;
+   virtual Expression get_expr() = 0;
+   virtual Symbol get_name() = 0;
 
 #ifdef Case_EXTRAS
    Case_EXTRAS
@@ -216,6 +227,35 @@ bool feat_is_method()
      return expr;
    }
 
+   Symbol get_name()
+   {
+        return name;
+   }
+   Formals get_formals()
+   {
+      return formals;
+   }
+   /* We extract the Symbols from out of the formals list */
+   std::vector<Symbol> get_params_and_rt()
+   {
+      std::vector<Symbol> params_and_rt;
+      for(int i = formals->first(); formals->more(i); i = formals->next(i))
+      {
+         Symbol formal_type = *(formals->nth(i)->get_type_decl());
+         params_and_rt.push_back(formal_type);
+      }
+      params_and_rt.push_back(return_type);
+      return params_and_rt;
+   }
+   Expression get_expression_to_check()
+   {
+      return expr;
+   }
+   Symbol get_return_type()
+   {
+      return return_type;
+   }
+
 
 #ifdef Feature_SHARED_EXTRAS
    Feature_SHARED_EXTRAS
@@ -256,6 +296,28 @@ public:
    {
      return init;
    }
+
+   Symbol get_name()
+   {
+        return name;
+   }
+   Formals get_formals()
+   {
+      return (Formals) NULL;
+   }
+   std::vector<Symbol> get_params_and_rt()
+   {
+      // attributes have no parameters or return type
+      return std::vector<Symbol>();
+   }
+   Expression get_expression_to_check()
+   {
+      return init;
+   }
+   Symbol get_return_type()
+   {
+      return type_decl;
+   }
   void code(ostream&){
 
    
@@ -316,6 +378,18 @@ public:
    }
    Case copy_Case();
    void dump(ostream& stream, int n);
+   Symbol get_type_decl()
+   {
+      return type_decl;
+   }
+   Expression get_expr()
+   {
+      return expr;
+   }
+   Symbol get_name()
+   {
+      return name;
+   }
 
 #ifdef Case_SHARED_EXTRAS
    Case_SHARED_EXTRAS
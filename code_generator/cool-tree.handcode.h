@@ -8,6 +8,12 @@
 #include "tree.h"
 #include "cool.h"
 #include "stringtab.h"
+#include "symtab.h"
+#include <map>
+#include <vector>
+#include <utility>
+class TypeEnv;
+
 #define yylineno curr_lineno;
 extern int yylineno;
 
@@ -45,14 +51,18 @@ typedef list_node<Case> Cases_class;
 typedef Cases_class *Cases;
 
 #define Program_EXTRAS                          \
+virtual void semant() = 0;			\
 virtual void cgen(ostream&) = 0;		\
-virtual void dump_with_types(ostream&, int) = 0; 
+virtual void dump_with_types(ostream&, int) = 0; \
+virtual void verify_type_of_all_class_features(SymbolTable<Symbol,Symbol> *,const TypeEnv &,Symbol) = 0;
 
 
 
 #define program_EXTRAS                          \
+void semant();     				\
 void cgen(ostream&);     			\
-void dump_with_types(ostream&, int);            
+void dump_with_types(ostream&, int);            \
+void verify_type_of_all_class_features(SymbolTable<Symbol,Symbol> *,const TypeEnv &,Symbol);
 
 #define Class__EXTRAS                   \
 virtual Symbol get_name() = 0;  	\
@@ -98,16 +108,50 @@ void dump_with_types(ostream& ,int);
 
 #define Expression_EXTRAS                    \
 Symbol type;                                 \
+int temps;                                   \
+int folded;                                  \
+int fold_value;                              \
 Symbol get_type() { return type; }           \
 Expression set_type(Symbol s) { type = s; return this; } \
 virtual void code(ostream&) = 0; \
+virtual int temps_needed() = 0;              \
+int get_temps_needed() { if (temps < 0) temps = temps_needed(); return temps; } \
+virtual bool constant_value(int&) { return false; } \
+bool fold(int& value) { if (folded < 0) folded = constant_value(fold_value); value = fold_value; return folded; } \
+virtual void code_unboxed(ostream&);         \
+virtual int tree_size() = 0;                 \
+virtual bool rebinds(Formals) = 0;           \
+virtual void add_constants() = 0;            \
 virtual void dump_with_types(ostream&,int) = 0;  \
 void dump_type(ostream&, int);               \
-Expression_class() { type = (Symbol) NULL; }
+Expression_class() { type = (Symbol) NULL; temps = -1; folded = -1; fold_value = 0; }
+
+// Int and Bool expressions that have an unboxed value: see "Unboxed
+// arithmetic" in cgen.cc.
+#define unboxed_EXTRAS                     \
+bool constant_value(int&);                 \
+void code_unboxed(ostream&);
+
+#define plus_EXTRAS unboxed_EXTRAS
+#define sub_EXTRAS unboxed_EXTRAS
+#define mul_EXTRAS unboxed_EXTRAS
+#define divide_EXTRAS unboxed_EXTRAS
+#define neg_EXTRAS unboxed_EXTRAS
+#define lt_EXTRAS unboxed_EXTRAS
+#define eq_EXTRAS unboxed_EXTRAS
+#define leq_EXTRAS unboxed_EXTRAS
+#define comp_EXTRAS unboxed_EXTRAS
+#define int_const_EXTRAS bool constant_value(int&);
+#define bool_const_EXTRAS bool constant_value(int&);
 
 #define Expression_SHARED_EXTRAS           \
 void code(ostream&); 			   \
-void dump_with_types(ostream&,int); 
+int temps_needed();                        \
+int tree_size();                           \
+bool rebinds(Formals);                     \
+void add_constants();                      \
+void dump_with_types(ostream&,int);       \
+Symbol type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol);
 
 
 #endif
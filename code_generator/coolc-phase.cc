@@ -0,0 +1,251 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  coolc-phase.cc
+//
+//  Single-process driver.  The lexer (../lexer/cool.flex), the parser
+//  (../parser/cool.y), the semantic checker (../semanticananalyzer/semant.cc)
+//  and the code generator are linked into one binary, and the Program
+//  built by the parser is handed straight to semant() and cgen().  There
+//  is no dump_with_types/ast-parse round trip and only one process.
+//
+//  Only lexing is parallel: the files are lexed on COOLC_THREADS threads
+//  (default: one per core), each file's symbols kept in its own
+//  CoolSpellings.  Parsing is serial, one file after another in
+//  command-line order, and the symbols enter the string tables as the
+//  parser takes their tokens, so the tables and the constant labels
+//  they produce are the same for any number of threads.  With -v the
+//  front end's wall time is reported.
+//
+//  If COOLC_TOKEN_CACHE names a directory, each file's token stream is
+//  saved there under a hash of the file's contents, and an unchanged
+//  file is replayed from its saved stream instead of being lexed.  With
+//  -v the cache's hits and misses are reported.  A saved stream records
+//  which scanner and token numbers wrote it; after a change to either
+//  it counts as a miss, and the file is lexed and saved again.
+//
+//  usage: coolc [flags] file1.cl file2.cl ...
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <unistd.h>
+#include "cool-tree.h"
+#include "cool-lex.h"
+
+//
+// The lexer reads from fin and the parser reports errors against
+// curr_filename; in the separate phases these belong to the phase mains.
+//
+FILE *fin;
+char *curr_filename = "<stdin>";
+
+extern int curr_lineno;
+extern int omerrs;
+extern Classes parse_results;
+extern Program ast_root;
+extern char *out_filename;
+extern int verbose_flag;
+
+extern int cool_yyparse(void);
+extern void handle_flags(int argc, char *argv[]);
+extern int optind;
+
+//
+// Every file is scanned to a token stream by a worker with its own
+// CoolLexer; workers take the next file from a shared counter.  The
+// symbols of file i stay in spellings[i] until it is parsed.
+//
+struct LexWork {
+  FILE **files;
+  std::vector<std::vector<CoolToken> > & tokens;
+  std::vector<CoolSpellings> & spellings;
+  const char *cache_dir;
+  std::atomic<size_t> next;
+  std::atomic<int> cache_hits;
+  std::atomic<int> cache_misses;
+
+  LexWork(FILE **f, std::vector<std::vector<CoolToken> > & t, std::vector<CoolSpellings> & sp, const char *dir)
+    : files(f), tokens(t), spellings(sp), cache_dir(dir), next(0), cache_hits(0), cache_misses(0) { }
+};
+
+// the cache file for f's contents: a 64-bit FNV-1a hash in hex
+static std::string token_cache_path(const char *dir, FILE *f)
+{
+  unsigned long long hash = 14695981039346656037ULL;
+  char buf[65536];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+    for (size_t i = 0; i < n; i++)
+      hash = (hash ^ (unsigned char) buf[i]) * 1099511628211ULL;
+  rewind(f);
+
+  char name[32];
+  snprintf(name, sizeof(name), "/%016llx.tok", hash);
+  return std::string(dir) + name;
+}
+
+static bool read_token_cache(const std::string & path, std::vector<CoolToken> & tokens,
+                             CoolSpellings *spellings)
+{
+  FILE *f = fopen(path.c_str(), "rb");
+  if (f == NULL)
+    return false;
+  bool ok = cool_read_tokens(f, tokens, spellings);
+  fclose(f);
+  return ok;
+}
+
+// written under a temporary name, so other runs never see half a file
+static void write_token_cache(const std::string & path, const std::vector<CoolToken> & tokens)
+{
+  char suffix[32];
+  snprintf(suffix, sizeof(suffix), ".%d.%p", (int) getpid(), (void *) &tokens);
+  std::string tmp = path + suffix;
+  FILE *f = fopen(tmp.c_str(), "wb");
+  if (f == NULL)
+    return;
+  bool ok = cool_write_tokens(f, tokens);
+  if (fclose(f) == 0 && ok)
+    rename(tmp.c_str(), path.c_str());
+  else
+    unlink(tmp.c_str());
+}
+
+static void lex_files(LexWork *work)
+{
+  CoolLexer lexer;
+  for (size_t i = work->next++; i < work->tokens.size(); i = work->next++) {
+    std::string cache_path;
+    if (work->cache_dir != NULL) {
+      cache_path = token_cache_path(work->cache_dir, work->files[i]);
+      if (read_token_cache(cache_path, work->tokens[i], &work->spellings[i])) {
+        work->cache_hits++;
+        fclose(work->files[i]);
+        continue;
+      }
+      work->cache_misses++;
+    }
+
+    lexer.spellings = &work->spellings[i];
+    lexer.start(work->files[i]);
+    lexer.record(work->tokens[i]);
+    fclose(work->files[i]);
+    if (work->cache_dir != NULL)
+      write_token_cache(cache_path, work->tokens[i]);
+  }
+}
+
+static unsigned lex_threads(size_t nfiles)
+{
+  unsigned num_threads = std::thread::hardware_concurrency();
+  char *env = getenv("COOLC_THREADS");
+  if (env != NULL)
+    num_threads = atoi(env);
+  if (num_threads == 0) num_threads = 1;
+  if (num_threads > nfiles) num_threads = nfiles;
+  return num_threads;
+}
+
+int main(int argc, char *argv[])
+{
+  handle_flags(argc,argv);
+  int firstfile_index = optind;
+
+  if (firstfile_index == argc) {
+    cerr << "usage: coolc [flags] file1.cl file2.cl ..." << endl
+         << "environment:" << endl
+         << "  COOLC_THREADS=n        lex on n threads (default: one per core)" << endl
+         << "  COOLC_TOKEN_CACHE=dir  keep token streams in dir and reuse them" << endl
+         << "  COOLC_INLINE_SIZE=n    with -O, inline method bodies of up to n AST nodes" << endl
+         << "                         (default 8; 0 turns inlining off)" << endl
+         << "  COOLC_COUNT_ALLOCS=1   make Main.main print how many objects were allocated" << endl;
+    exit(1);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  size_t nfiles = argc - firstfile_index;
+  std::vector<FILE *> files(nfiles);
+  for (size_t i = 0; i < nfiles; i++) {
+    files[i] = fopen(argv[firstfile_index + i], "r");
+    if (files[i] == NULL) {
+      cerr << "Could not open input file " << argv[firstfile_index + i] << endl;
+      exit(1);
+    }
+  }
+
+  std::vector<std::vector<CoolToken> > tokens(nfiles);
+  std::vector<CoolSpellings> spellings(nfiles);
+  LexWork work(files.data(), tokens, spellings, getenv("COOLC_TOKEN_CACHE"));
+  unsigned num_threads = lex_threads(nfiles);
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < num_threads; t++)
+    workers.push_back(std::thread(lex_files, &work));
+  lex_files(&work);
+  for (size_t t = 0; t < workers.size(); t++)
+    workers[t].join();
+
+  //
+  // Parse the token streams into one class list, in command-line order.
+  // The parser stays on this thread: tree nodes take their line numbers
+  // from the global node_lineno, and its actions use the string tables
+  // without a lock.  The replaying lexer interns each symbol from the
+  // file's spellings as the parser reads it.  parse_results holds the
+  // classes of the file just parsed.
+  //
+  CoolLexer lexer;
+  cool_lexer = &lexer;
+  Classes classes = nil_Classes();
+  for (size_t i = 0; i < nfiles; i++) {
+    curr_filename = argv[firstfile_index + i];
+    curr_lineno = 1;
+    parse_results = nil_Classes();
+    lexer.spellings = &spellings[i];
+    lexer.replay(tokens[i].data(), tokens[i].size());
+    cool_yyparse();
+    classes = append_Classes(classes, parse_results);
+  }
+
+  if (verbose_flag) {
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    cerr << "front end: " << nfiles << " files, " << num_threads << " threads, "
+         << secs.count() << " s" << endl;
+    if (work.cache_dir != NULL)
+      cerr << "token cache: " << work.cache_hits << " hits, "
+           << work.cache_misses << " misses" << endl;
+  }
+
+  if (omerrs != 0) {
+    cerr << "Compilation halted due to lex and parse errors\n";
+    exit(1);
+  }
+
+  ast_root = program(classes);
+  ast_root->semant();
+
+  if (!out_filename) {   // no -o option
+    char *base = strdup(argv[firstfile_index]);
+    char *dot = strrchr(base, '.');
+    if (dot) *dot = '\0'; // strip off file extension
+    out_filename = new char[strlen(base)+8];
+    strcpy(out_filename, base);
+    strcat(out_filename, ".s");
+    free(base);
+  }
+
+  ofstream s(out_filename);
+  if (!s) {
+    cerr << "Cannot open output file " << out_filename << endl;
+    exit(1);
+  }
+  ast_root->cgen(s);
+  return 0;
+}
@@ -0,0 +1,23 @@
+(*
+ * Dispatch through an attribute whose static type is the parent class.
+ * B overrides count() and adds aardvark(), whose name sorts before every
+ * inherited method; B's dispatch table must still keep value() and
+ * count() in the slots they have in A's.
+ *
+ * expected output: 12
+ *)
+
+class A {
+  value() : Int { 1 };
+  count() : Int { 0 };
+};
+
+class B inherits A {
+  aardvark() : Int { 9 };
+  count() : Int { 2 };
+};
+
+class Main inherits IO {
+  x : A <- new B;
+  main() : Object { out_int(x.value()).out_int(x.count()) };
+};
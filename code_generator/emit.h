@@ -25,6 +25,8 @@
 #define BOOLTAG              "_bool_tag"
 #define STRINGTAG            "_string_tag"
 #define HEAP_START           "heap_start"
+#define ALLOC_COUNT          "_alloc_count"
+#define ALLOC_COUNT_MSG      "_alloc_count_msg"
 
 // Naming conventions
 #define DISPTAB_SUFFIX       "_dispTab"
@@ -74,6 +76,7 @@
 #define SP   "$sp"		// Stack pointer 
 #define FP   "$fp"		// Frame pointer 
 #define RA   "$ra"		// Return address 
+#define V0   "$v0"		// System call number and result
 
 //
 // Opcodes
@@ -81,6 +84,7 @@
 #define JALR  "\tjalr\t"  
 #define JAL   "\tjal\t"                 
 #define RET   "\tjr\t"RA"\t"
+#define SYSCALL "\tsyscall"
 
 #define SW    "\tsw\t"
 #define LW    "\tlw\t"
@@ -97,6 +101,10 @@
 #define MUL   "\tmul\t"
 #define SUB   "\tsub\t"
 #define SLL   "\tsll\t"
+#define SLT   "\tslt\t"
+#define SLTIU "\tsltiu\t"
+#define XOR   "\txor\t"
+#define XORI  "\txori\t"
 #define BEQZ  "\tbeqz\t"
 #define BRANCH   "\tb\t"
 #define BEQ      "\tbeq\t"
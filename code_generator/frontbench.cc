@@ -0,0 +1,208 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  frontbench.cc
+//
+//  Measures the front end on the given files, the lexer and the parser
+//  separately.  With -l every file is lexed to a token stream; with -p
+//  the files are lexed once, untimed, and the recorded streams are then
+//  parsed.  Each timed pass is repeated and averaged.  The AST is
+//  counted from its dump_with_types listing, outside the timed region.
+//
+//  The memory of a phase is how far the resident set grew above where
+//  it stood when the phase began: for -l during the first lex, which
+//  builds the token streams and the string tables, and for -p during
+//  the first parse, which builds the AST from streams already in
+//  memory.  The peak is reset before the phase through
+//  /proc/self/clear_refs, so an earlier, higher peak does not hide it.
+//
+//  usage: frontbench -l|-p [-n repetitions] file1.cl file2.cl ...
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <vector>
+#include <chrono>
+#include <streambuf>
+#include "cool-tree.h"
+#include "cool-lex.h"
+
+FILE *fin;
+char *curr_filename = "<stdin>";
+
+extern int curr_lineno;
+extern int omerrs;
+extern Classes parse_results;
+extern Program ast_root;
+extern int cool_yyparse(void);
+
+// counts the "#line" that dump_with_types writes first for every node
+class NodeCounter : public std::streambuf {
+public:
+  long nodes;
+  NodeCounter() : nodes(0), line_start(true) { }
+protected:
+  int overflow(int c) {
+    if (c == '#' && line_start)
+      nodes++;
+    if (c == '\n')
+      line_start = true;
+    else if (c != ' ')
+      line_start = false;
+    return c;
+  }
+private:
+  bool line_start;
+};
+
+static double now()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// the resident set and its peak in KB, from /proc/self/status
+static void read_rss_kb(long *rss, long *peak)
+{
+  *rss = *peak = 0;
+  FILE *f = fopen("/proc/self/status", "r");
+  if (f != NULL) {
+    char line[256];
+    while (fgets(line, sizeof(line), f) != NULL) {
+      sscanf(line, "VmRSS: %ld", rss);
+      sscanf(line, "VmHWM: %ld", peak);
+    }
+    fclose(f);
+  }
+  if (*peak == 0) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    *peak = usage.ru_maxrss;
+  }
+}
+
+// starts a phase: lowers the peak to the current resident set
+static long phase_start_rss_kb()
+{
+  FILE *f = fopen("/proc/self/clear_refs", "w");
+  if (f != NULL) {
+    fputs("5", f);
+    fclose(f);
+  }
+  long rss, peak;
+  read_rss_kb(&rss, &peak);
+  return rss;
+}
+
+// how far the peak has risen above the resident set at the phase's start
+static long phase_rss_kb(long start)
+{
+  long rss, peak;
+  read_rss_kb(&rss, &peak);
+  return peak > start ? peak - start : 0;
+}
+
+static long lex_files(char **files, int nfiles, std::vector<std::vector<CoolToken> > & tokens)
+{
+  CoolLexer lexer;
+  long bytes = 0;
+  for (int i = 0; i < nfiles; i++) {
+    FILE *f = fopen(files[i], "r");
+    if (f == NULL) {
+      cerr << "Could not open input file " << files[i] << endl;
+      exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    bytes += ftell(f);
+    rewind(f);
+    tokens[i].clear();
+    lexer.start(f);
+    lexer.record(tokens[i]);
+    fclose(f);
+  }
+  return bytes;
+}
+
+// parses every stream; returns the number of AST nodes if count is set
+static long parse_files(char **files, int nfiles,
+                        std::vector<std::vector<CoolToken> > & tokens, bool count)
+{
+  CoolLexer lexer;
+  cool_lexer = &lexer;
+  NodeCounter counter;
+  ostream out(&counter);
+  for (int i = 0; i < nfiles; i++) {
+    curr_filename = files[i];
+    curr_lineno = 1;
+    lexer.replay(tokens[i].data(), tokens[i].size());
+    ast_root = NULL;
+    cool_yyparse();
+    if (count && ast_root != NULL)
+      ast_root->dump_with_types(out, 0);
+  }
+  cool_lexer = NULL;
+  return counter.nodes;
+}
+
+int main(int argc, char *argv[])
+{
+  int reps = 5;
+  char mode = 0;
+  int c;
+  while ((c = getopt(argc, argv, "lpn:")) != -1) {
+    switch (c) {
+    case 'l': case 'p': mode = c; break;
+    case 'n': reps = atoi(optarg); break;
+    default: mode = 0; break;
+    }
+  }
+  if (mode == 0 || optind >= argc || reps <= 0) {
+    cerr << "usage: frontbench -l|-p [-n repetitions] file1.cl file2.cl ..." << endl;
+    exit(1);
+  }
+
+  char **files = argv + optind;
+  int nfiles = argc - optind;
+  std::vector<std::vector<CoolToken> > tokens(nfiles);
+  long ntokens = 0;
+  long rss = phase_start_rss_kb();
+  long bytes = lex_files(files, nfiles, tokens);
+  if (mode == 'l')
+    rss = phase_rss_kb(rss);
+  for (int i = 0; i < nfiles; i++)
+    ntokens += tokens[i].size() - 1;     // not the final 0
+
+  double secs = 0;
+  long nodes = 0;
+  for (int r = 0; r < reps; r++) {
+    if (mode == 'p' && r == 0)
+      rss = phase_start_rss_kb();
+    double start = now();
+    if (mode == 'l')
+      lex_files(files, nfiles, tokens);
+    else
+      parse_files(files, nfiles, tokens, false);
+    secs += now() - start;
+    if (mode == 'p' && r == 0)
+      rss = phase_rss_kb(rss);
+  }
+  if (omerrs != 0) {
+    cerr << "frontbench: the input has lex or parse errors" << endl;
+    exit(1);
+  }
+  secs /= reps;
+
+  if (mode == 'l') {
+    printf("%8s %12s %12s %14s %14s %10s\n", "phase", "MB", "tokens", "MB/s", "tokens/s", "+RSS KB");
+    printf("%8s %12.2f %12ld %14.2f %14.0f %10ld\n", "lex",
+           bytes / (1024.0 * 1024.0), ntokens, bytes / (1024.0 * 1024.0) / secs, ntokens / secs, rss);
+  } else {
+    nodes = parse_files(files, nfiles, tokens, true);
+    printf("%8s %12s %12s %14s %14s %10s\n", "phase", "tokens", "nodes", "tokens/s", "nodes/s", "+RSS KB");
+    printf("%8s %12ld %12ld %14.0f %14.0f %10ld\n", "parse",
+           ntokens, nodes, ntokens / secs, nodes / secs, rss);
+  }
+  return 0;
+}
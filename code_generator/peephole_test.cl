@@ -0,0 +1,15 @@
+(*
+ * Arithmetic for test_peephole.sh. Compiled with -r, each of the four
+ * operators in f() pushes its left operand while its right operand, an
+ * attribute, is loaded, and pops it back into $t1. The chain leans left,
+ * so no right operand makes a call or uses $t1 itself, and the Bool
+ * result is boxed without a push.
+ *)
+
+class Main {
+  a : Int <- 1;
+  b : Int <- 2;
+  c : Int <- 3;
+  f() : Bool { ((a + b) - c) * a < b };
+  main() : Object { f() };
+};
@@ -0,0 +1,25 @@
+(*
+ * Recursive methods must not be inlined into themselves. f() calls
+ * itself, and g() and h() call each other; all three bodies are small
+ * enough to inline.
+ *
+ * Main.f, Main.g and Main.h must each keep a call to the recursive
+ * method rather than a copy of their own body. After
+ *
+ *   ./coolc -O recursion_test.cl
+ *
+ * the code from the Main.f: label to its jr holds exactly one
+ * "jal Main.f" and no "lw $s0 4($sp)", the load that ends an inlined
+ * body. Main.g may inline h() once, but it must call g() back rather
+ * than inline it; Main.h does the same with g().
+ *
+ * This program is only meant to be compiled. Running it recurses forever.
+ *)
+
+class Main inherits IO {
+  n : Int <- 0;
+  f() : Int { (n <- n + 1) + f() };
+  g() : Int { (n <- n + 2) + h() };
+  h() : Int { (n <- n + 3) + g() };
+  main() : Object { out_int(f() + g()) };
+};
@@ -0,0 +1,23 @@
+#!/bin/bash
+#
+# Compiles peephole_test.cl with -r, where each Int operator keeps its
+# left operand on the stack, once without and once with -O. With -O the
+# peephole pass must turn every push/pop pair in Main.f into a move.
+#
+
+TMP=${TMPDIR:-/tmp}/test_peephole.$$
+mkdir -p $TMP
+
+# the 4-byte pushes between the Main.f label and its return
+pushes() {
+	awk '/^Main.f:/,/jr/' $1 | grep -c '	addiu	\$sp \$sp -4$'
+}
+
+./coolc -r -o $TMP/plain.s peephole_test.cl || exit 1
+./coolc -r -O -o $TMP/opt.s peephole_test.cl || exit 1
+before=$(pushes $TMP/plain.s)
+after=$(pushes $TMP/opt.s)
+rm -rf $TMP
+
+echo "pushes in Main.f: $before without -O, $after with -O"
+[ "$before" -eq 4 ] && [ "$after" -eq 0 ]
@@ -0,0 +1,129 @@
+#!/bin/bash
+#
+# Builds the lexer of each given revision and compares the scanners:
+# flex's statistics for the generated DFA, the text and data size of
+# cool-lex.o, and the best of reps runs of ./lexer over a generated
+# corpus, as MB/s and tokens/s.  "." is the working tree.  To measure a
+# lexer change, give the commit before it and the commit itself.
+#
+#   code      classes full of keywords, in mixed case, and identifiers
+#   comments  the same code under nested and line comments several
+#             times its size
+#
+#   ./bench_revs.sh [-n reps] [-k kilobytes] [-s shape] rev1 rev2 ...
+#                   default: 5 reps, a 4096 KB corpus of code
+#
+# ./lexer prints every token.  Its output goes to /dev/null, so the rates
+# include the printing, which is the same for every revision.
+#
+# Revisions that have lexbench are also run through it, on the same
+# corpus, to compare reading the file with fread against mapping it.
+#
+
+REPS=5
+KB=4096
+SHAPE=code
+while getopts "n:k:s:" opt; do
+	case $opt in
+	n) REPS=$OPTARG ;;
+	k) KB=$OPTARG ;;
+	s) SHAPE=$OPTARG ;;
+	*) exit 1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+if [ $# -eq 0 ]; then
+	echo "usage: bench_revs.sh [-n reps] [-k kilobytes] [-s code|comments] rev1 rev2 ..." >&2
+	exit 1
+fi
+HERE=$(cd $(dirname $0) && pwd)
+TMP=${TMPDIR:-/tmp}/bench_revs.$$
+mkdir -p $TMP
+
+# identifiers and keywords in every case the language allows
+gen_code() {
+	i=0
+	while [ $(wc -c < $1) -lt $((KB * 1024)) ]; do
+		for ((j = 0; j < 50; j++, i++)); do
+			echo "Class C$i Inherits IO {"
+			echo "  count$i : Int <- $i;"
+			echo "  name$i : String <- \"c$i\";"
+			echo "  f(x : Int, y : Bool) : Object {"
+			echo "    IF y THEN WHILE x < count$i LOOP x <- x + 1 POOL ELSE"
+			echo "      let z : Int <- x * 2 in case z of n : Int => isvoid n; esac fi"
+			echo "  };"
+			echo "  g() : SELF_TYPE { { out_string(name$i); new SELF_TYPE; } };"
+			echo "};"
+		done >> $1
+	done
+}
+
+gen_comments() {
+	i=0
+	while [ $(wc -c < $1) -lt $((KB * 1024)) ]; do
+		for ((j = 0; j < 50; j++, i++)); do
+			echo "(* C$i keeps a count and a name, and prints the name."
+			for ((k = 0; k < 8; k++)); do
+				echo "   Line $k of the description: f loops while x is below the count, *"
+				echo "   (* a nested remark $k about the loop *) and g returns a new object."
+			done
+			echo "*)"
+			echo "Class C$i Inherits IO {"
+			echo "  -- the count, set once when the object is made; f compares against it"
+			echo "  count$i : Int <- $i;  -- initial value"
+			echo "  f(x : Int) : Object { WHILE x < count$i LOOP x <- x + 1 POOL };"
+			echo "};"
+		done >> $1
+	done
+}
+
+# prints the best time of reps runs of a command, in seconds
+best_time() {
+	best=
+	for ((r = 0; r < REPS; r++)); do
+		t=$( { TIMEFORMAT=%R; time "$@" > /dev/null; } 2>&1 )
+		best=$(awk -v a="$best" -v b="$t" 'BEGIN { print (a == "" || b < a) ? b : a }')
+	done
+	echo $best
+}
+
+corpus=$TMP/corpus.cl
+: > $corpus
+gen_$SHAPE $corpus || exit 1
+bytes=$(wc -c < $corpus)
+echo "corpus: $SHAPE, $bytes bytes"
+printf "%-12s %-28s %-14s %10s %10s %12s\n" "revision" "DFA states" "table entries" "lex.o B" "MB/s" "tokens/s"
+
+for rev in "$@"; do
+	dir=$TMP/$(echo $rev | tr -c 'A-Za-z0-9\n' _)
+	mkdir -p $dir
+	if [ "$rev" = . ]; then
+		cp -P $HERE/* $dir/ 2>/dev/null
+	else
+		(cd $HERE && git archive $rev .) | tar -x -C $dir || exit 1
+	fi
+	rm -f $dir/cool-lex.cc $dir/*.o
+	(cd $dir && make -s lexer > $dir/build.log 2>&1) || { echo "$rev: build failed, see $dir/build.log"; continue; }
+
+	stats=$(cd $dir && flex -v -ostats.cc cool.flex 2>&1 > /dev/null)
+	states=$(echo "$stats" | grep "DFA states" | sed 's/^ *//')
+	entries=$(echo "$stats" | grep "table entries" | awk '{ print $1 }')
+	obj=$(size $dir/cool-lex.o | awk 'NR == 2 { print $1 + $2 }')
+	tokens=$($dir/lexer $corpus | grep -c '^#[0-9]')
+	secs=$(best_time $dir/lexer $corpus)
+	printf "%-12s %-28s %-14s %10s %10.2f %12.0f\n" "$rev" "$states" "$entries" "$obj" \
+		$(awk -v b=$bytes -v s=$secs 'BEGIN { print b / 1048576 / s }') \
+		$(awk -v n=$tokens -v s=$secs 'BEGIN { print n / s }')
+
+	if grep -q '^lexbench' $dir/Makefile && (cd $dir && make -s lexbench >> $dir/build.log 2>&1); then
+		$dir/lexbench -n $REPS $corpus | sed "s|^|$rev |" >> $TMP/lexbench.out
+	fi
+done
+
+if [ -s $TMP/lexbench.out ]; then
+	echo
+	echo "lexbench, fread against mmap:"
+	cat $TMP/lexbench.out
+fi
+
+rm -rf $TMP
@@ -0,0 +1,118 @@
+/*
+ *  cool-lex.h
+ *
+ *  A COOL scanner instance. Each CoolLexer has its own flex buffers,
+ *  string constant buffer, comment depth and line counter, so separate
+ *  instances can scan separate files on separate threads. Symbols are
+ *  interned in the shared idtable, inttable and stringtable, unless the
+ *  scanner is given a CoolSpellings to keep them in instead.
+ *
+ *  The parser calls cool_yylex(), which scans with cool_lexer (a default
+ *  instance reading fin if it is NULL) and copies the token's value and
+ *  line into the globals cool_yylval and curr_lineno.
+ */
+
+#ifndef _COOL_LEX_H
+#define _COOL_LEX_H
+
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cool-parse.h>
+
+/* a token as returned by CoolLexer::next() */
+struct CoolToken {
+  int token;
+  int lineno;
+  YYSTYPE yylval;
+};
+
+/*
+ * The symbols of one file, kept apart from the shared tables. A table's
+ * entries are numbered in the order they are added, and that order ends
+ * up in the generated code's constant labels; threads lexing several
+ * files at once would add them in whatever order the threads ran.
+ * Scanned into a CoolSpellings instead, a file's symbols reach the
+ * tables only when its tokens are replayed to the parser, in the same
+ * order as if the parser had scanned the file itself.
+ */
+class CoolSpellings {
+private:
+  std::unordered_map<std::string, Symbol> symbols;
+
+  CoolSpellings(const CoolSpellings &) = delete;
+  CoolSpellings &operator=(const CoolSpellings &) = delete;
+
+public:
+  CoolSpellings() { }
+  ~CoolSpellings();
+
+  /* this file's Symbol for s[0..len), whatever the kind of token */
+  Symbol add(char *s, int len);
+};
+
+class CoolLexer {
+private:
+  void *scanner;                /* flex's yyscan_t */
+  char *mapped_text;
+  size_t mapped_len;
+  void *mapped_buffer;
+  const CoolToken *replay_next;
+  const CoolToken *replay_end;
+
+  int map_file(FILE *f);
+  void unmap_file();
+
+public:
+  /* set by next() for the token it returns */
+  YYSTYPE yylval;
+  int lineno;
+
+  /*
+   * NULL: intern into the shared tables. Otherwise scanned tokens get
+   * their symbols from spellings, and replayed tokens are taken to have
+   * symbols from there, which next() interns before returning them.
+   */
+  CoolSpellings *spellings;
+
+  /* used by the rules in cool.flex */
+  FILE *in;                     /* NULL: read the global fin */
+  char *string_buf;             /* MAX_STR_CONST bytes */
+  int string_len;
+  int comment_depth;
+
+  CoolLexer();
+  ~CoolLexer();
+
+  /*
+   * Scan f from line 1. Unless map is false a regular file is mapped and
+   * scanned in place; anything else is read through fread. f is not
+   * closed.
+   */
+  void start(FILE *f, bool map = true);
+
+  /* returns the next token, or 0 at the end of the input */
+  int next();
+
+  /*
+   * Scan the rest of the input into tokens, ending with token 0. Error
+   * messages are copied, since some of them point into the scan buffer.
+   */
+  void record(std::vector<CoolToken> &tokens);
+
+  /* have next() return tokens[0..n) instead of scanning */
+  void replay(const CoolToken *tokens, int n);
+};
+
+extern CoolLexer *cool_lexer;
+
+/*
+ * Token streams on disk, for coolc's token cache. Both return 0 on
+ * failure; a stream that cannot be read leaves tokens empty. Read
+ * symbols go into spellings, as a scanner's would, unless it is NULL.
+ */
+int cool_write_tokens(FILE *f, const std::vector<CoolToken> &tokens);
+int cool_read_tokens(FILE *f, std::vector<CoolToken> &tokens, CoolSpellings *spellings = NULL);
+
+#endif
@@ -0,0 +1,122 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  lexbench.cc
+//
+//  Measures lexer throughput on the given files, once reading them
+//  through YY_INPUT (fread) and once mapping them.  Both modes scan the
+//  same files the same number of times after one untimed pass that fills
+//  the string tables.  With -j the files are divided among that many
+//  threads, each scanning with its own CoolLexer.
+//
+//  usage: lexbench [-n repetitions] [-j threads] file1.cl file2.cl ...
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "cool-lex.h"
+
+FILE *fin;
+char *curr_filename = "<stdin>";
+int curr_lineno = 1;
+YYSTYPE cool_yylval;
+
+static double now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+struct ScanWork {
+  char **files;
+  int nfiles;
+  int reps;
+  int thread;          // this worker scans files thread, thread+threads, ...
+  int threads;
+  bool use_mmap;
+  long tokens;
+  long bytes;
+};
+
+static void *scan_files(void *arg)
+{
+  ScanWork *work = (ScanWork *) arg;
+  CoolLexer lexer;
+  for (int r = 0; r < work->reps; r++) {
+    for (int i = work->thread; i < work->nfiles; i += work->threads) {
+      FILE *f = fopen(work->files[i], "r");
+      if (f == NULL) {
+        fprintf(stderr, "Could not open input file %s\n", work->files[i]);
+        exit(1);
+      }
+      fseek(f, 0, SEEK_END);
+      work->bytes += ftell(f);
+      rewind(f);
+
+      lexer.start(f, work->use_mmap);
+      while (lexer.next() != 0)
+        work->tokens++;
+      fclose(f);
+    }
+  }
+  return NULL;
+}
+
+/* scans every file reps times on the given number of threads */
+static void run(char **files, int nfiles, int reps, int threads, bool use_mmap,
+                long *tokens, long *bytes)
+{
+  ScanWork *work = new ScanWork[threads];
+  pthread_t *ids = new pthread_t[threads];
+  for (int t = 0; t < threads; t++) {
+    ScanWork w = { files, nfiles, reps, t, threads, use_mmap, 0, 0 };
+    work[t] = w;
+    pthread_create(&ids[t], NULL, scan_files, &work[t]);
+  }
+  *tokens = *bytes = 0;
+  for (int t = 0; t < threads; t++) {
+    pthread_join(ids[t], NULL);
+    *tokens += work[t].tokens;
+    *bytes += work[t].bytes;
+  }
+  delete [] ids;
+  delete [] work;
+}
+
+int main(int argc, char **argv)
+{
+  int reps = 10;
+  int threads = 1;
+  int c;
+  while ((c = getopt(argc, argv, "n:j:")) != -1) {
+    switch (c) {
+    case 'n': reps = atoi(optarg); break;
+    case 'j': threads = atoi(optarg); break;
+    default: reps = 0; break;
+    }
+  }
+  if (optind >= argc || reps <= 0 || threads <= 0) {
+    fprintf(stderr, "usage: lexbench [-n repetitions] [-j threads] file1.cl file2.cl ...\n");
+    exit(1);
+  }
+
+  long tokens, bytes;
+  run(argv + optind, argc - optind, 1, 1, false, &tokens, &bytes);
+
+  printf("%6s %8s %10s %10s %10s %14s\n", "input", "threads", "MB", "seconds", "MB/s", "tokens/s");
+  for (int mode = 0; mode < 2; mode++) {
+    bool use_mmap = (mode == 1);
+    double start = now();
+    run(argv + optind, argc - optind, reps, threads, use_mmap, &tokens, &bytes);
+    double secs = now() - start;
+    double mb = bytes / (1024.0 * 1024.0);
+    printf("%6s %8d %10.2f %10.3f %10.2f %14.0f\n", use_mmap ? "mmap" : "fread",
+           threads, mb, secs, mb / secs, tokens / secs);
+  }
+  return 0;
+}
@@ -1,8 +1,39 @@
+#!/bin/sh
+#
+# Diffs the lexer's output against the reference lexer's on examples/*.cl,
+# and against the saved expected output on every *_test.cl that has a
+# .out file.  With -u the .out files are first regenerated with the
+# reference lexer, which REFLEXER may name.  Exits 1 if anything differed.
+#
 
+REFLEXER=${REFLEXER:-/afs/ir.stanford.edu/class/cs143/bin/lexer}
+status=0
+
+if [ "$1" = "-u" ]; then
+	if [ ! -x $REFLEXER ]; then
+		echo "no reference lexer at $REFLEXER" >&2
+		exit 1
+	fi
+	for f in *_test.cl; do
+		[ -f ${f%.cl}.out ] || continue
+		$REFLEXER $f > ${f%.cl}.out
+	done
+fi
 
 for f in examples/*.cl; do
+	[ -f $f ] && [ -x $REFLEXER ] || continue
+	echo "File -> $f"
+	./lexer $f > my_output.txt
+	$REFLEXER $f > ref_output.txt
+	diff my_output.txt ref_output.txt || status=1
+done
+
+# tests that come with their expected output
+for f in *_test.cl; do
+	[ -f ${f%.cl}.out ] || continue
 	echo "File -> $f"
 	./lexer $f > my_output.txt
-	/afs/ir.stanford.edu/class/cs143/bin/lexer $f > ref_output.txt
-	diff my_output.txt ref_output.txt
+	diff my_output.txt ${f%.cl}.out || status=1
 done
+
+exit $status
@@ -0,0 +1,2 @@
+"no closing quote
+class Foo inherits IO
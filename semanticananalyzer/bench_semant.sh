@@ -0,0 +1,67 @@
+#!/bin/bash
+#
+# Times the semantic checker on synthetic programs of growing size.
+# Classes form one long inheritance chain and every method body has
+# dispatches, assignments, an if and a case, so each class exercises
+# conformance checks and joins deep in the hierarchy. When valgrind is
+# installed the heap allocation count of each run is reported as well;
+# it should grow with the size of the program, not with the number of
+# expressions times the number of classes.
+#
+#   ./bench_semant.sh [sizes...]      default sizes: 100 200 400 800
+#
+
+SIZES=${*:-"100 200 400 800"}
+TMP=${TMPDIR:-/tmp}/bench_semant.$$
+mkdir -p $TMP
+
+gen_program() {
+	n=$1
+	echo "class C1 inherits IO {"
+	echo "  a1 : Int <- 1;"
+	echo "  o1 : Object;"
+	echo "  m1(x : Int) : Int { { o1 <- self; a1 <- a1 + x; } };"
+	echo "};"
+	for ((i = 2; i <= n; i++)); do
+		p=$((i - 1))
+		echo "class C$i inherits C$p {"
+		echo "  a$i : Int <- $i;"
+		echo "  o$i : C1;"
+		echo "  m$i(x : Int, y : C$p) : C1 {"
+		echo "    { a$i <- m1(a$p + x);"
+		echo "      o$i <- if a$i < x then y else new C$i fi;"
+		echo "      o$i <- case y of c : C$p => c; d : Object => self; esac;"
+		echo "      y.m1(x);"
+		echo "      o$i; }"
+		echo "  };"
+		echo "};"
+	done
+	echo "class Main {"
+	echo "  c : C$n <- new C$n;"
+	echo "  main() : Object { c.m1(1) };"
+	echo "};"
+}
+
+if which valgrind > /dev/null 2>&1; then
+	printf "%8s %10s %14s %12s\n" classes seconds us/class allocs
+else
+	printf "%8s %10s %14s\n" classes seconds us/class
+fi
+for n in $SIZES; do
+	f=$TMP/bench$n.cl
+	gen_program $n > $f
+	./lexer $f | ./parser $f > $TMP/bench$n.ast
+	start=$(date +%s.%N)
+	./semant < $TMP/bench$n.ast > /dev/null
+	end=$(date +%s.%N)
+	line=$(echo "$n $start $end" | awk '{ t = $3 - $2; printf "%8d %10.3f %14.1f", $1, t, t * 1000000 / $1 }')
+	if which valgrind > /dev/null 2>&1; then
+		allocs=$(valgrind ./semant < $TMP/bench$n.ast 2>&1 > /dev/null | \
+			awk '/total heap usage/ { gsub(",", "", $5); print $5 }')
+		printf "%s %12s\n" "$line" "$allocs"
+	else
+		echo "$line"
+	fi
+done
+
+rm -rf $TMP
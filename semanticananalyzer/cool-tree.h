@@ -56,7 +56,7 @@ public:
    virtual bool feat_is_method() = 0;
    virtual Symbol get_name() = 0;
    virtual void set_type(Symbol s) = 0;
-   virtual Symbol* get_type_decl() = 0;
+   virtual Symbol get_type_decl() = 0;
    virtual std::vector<Symbol> get_params_and_rt() = 0;
    virtual Expression get_expression_to_check() = 0;
    virtual Symbol get_return_type() = 0;
@@ -90,11 +90,7 @@ class Expression_class : public tree_node {
 public:
    tree_node *copy()		 { return copy_Expression(); }
    virtual Expression copy_Expression() = 0;
-   virtual Symbol type_check(	SymbolTable<Symbol,Symbol> *symtab,
-				std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-				void*, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap ) = 0;
-   Symbol least_upper_bound (Symbol symbol1, Symbol symbol2, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap);
-   bool is_subtypeof(Symbol child, Symbol parent, std::map<Symbol,Symbol> _child_to_parent_classmap);
+   virtual Symbol type_check(	SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol) = 0;
 #ifdef Expression_EXTRAS
    Expression_EXTRAS
 #endif
@@ -227,7 +223,10 @@ public:
    Formals get_formals(){
       return formals;
    }
-     Symbol *get_type_decl();
+   Symbol get_type_decl()
+   {
+        return return_type;
+   }
 
 void set_type(Symbol s) { type = s;  } 
   
@@ -290,9 +289,9 @@ public:
    {
         return name;
    }
-   Symbol* get_type_decl()
+   Symbol get_type_decl()
    {
-        return &type_decl;
+        return type_decl;
    }
 
 void set_type(Symbol s) { type = s;  } 
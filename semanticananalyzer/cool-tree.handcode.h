@@ -12,6 +12,8 @@
 #include <utility>
 
 
+class TypeEnv;
+
 #define yylineno curr_lineno;
 extern int yylineno;
 
@@ -51,18 +53,14 @@ typedef Cases_class *Cases;
 #define Program_EXTRAS                          \
 virtual void semant() = 0;			\
 virtual void dump_with_types(ostream&, int) = 0; \
-virtual void add_own_attributes_to_scope(Symbol,std::map<Symbol,Class_>&,SymbolTable<Symbol,Symbol> *) = 0;	\
-virtual void add_parent_attributes_to_scope(std::map<Symbol,Symbol>&,std::map<Symbol,Class_>&,Symbol,SymbolTable<Symbol,Symbol> *) = 0;	\
-virtual void verify_type_of_all_class_features(SymbolTable<Symbol,Symbol> *,std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > &, void* ,Symbol,std::map<Symbol,Symbol>&,std::map<Symbol,Class_>&) = 0;
+virtual void verify_type_of_all_class_features(SymbolTable<Symbol,Symbol> *,const TypeEnv &,Symbol) = 0;
 
 
 
 #define program_EXTRAS                          \
 void semant();     				\
 void dump_with_types(ostream&,int);            \
-void add_own_attributes_to_scope(Symbol,std::map<Symbol,Class_>&,SymbolTable<Symbol,Symbol> *); 	\
-void add_parent_attributes_to_scope(std::map<Symbol,Symbol>&,std::map<Symbol,Class_>&,Symbol,SymbolTable<Symbol,Symbol> *);	\
-void verify_type_of_all_class_features(  SymbolTable<Symbol,Symbol> *,std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > &,void*,Symbol,std::map<Symbol,Symbol>&,std::map<Symbol,Class_> &);
+void verify_type_of_all_class_features(SymbolTable<Symbol,Symbol> *,const TypeEnv &,Symbol);
 
 
 
@@ -97,13 +95,13 @@ void dump_with_types(ostream&,int);
 
 #define Case_EXTRAS                             \
 virtual void dump_with_types(ostream& ,int) = 0; \
-Symbol type_check(SymbolTable<Symbol,Symbol> *symtab, std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap);
+Symbol type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol);
 
 
 
 #define branch_EXTRAS                                   \
 void dump_with_types(ostream& ,int); \
-Symbol type_check(SymbolTable<Symbol,Symbol> *symtab, std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map, void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap);
+Symbol type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol);
 
 
 
@@ -117,6 +115,6 @@ Expression_class() { type = (Symbol) NULL; }
 
 #define Expression_SHARED_EXTRAS           \
 void dump_with_types(ostream&,int);       \
-Symbol type_check(SymbolTable<Symbol,Symbol> *symtab, std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map, void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap);
+Symbol type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol);
 
 #endif
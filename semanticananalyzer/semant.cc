@@ -12,6 +12,8 @@
 #include <utility>
 #include "cool-tree.h"
 #include <iostream>
+#include <thread>
+#include <atomic>
 
 extern int semant_debug;
 extern char *curr_filename;
@@ -109,6 +111,12 @@ ClassTable::ClassTable(Classes classes) : 	_classes(classes),
                                             _child_to_parent_classmap(),
                                             _method_map(),
                                             _declared_classes_map(),   
+                                            _tree_index(),
+                                            _tree_class(),
+                                            _preorder(),
+                                            _postorder(),
+                                            _ancestor(),
+                                            _class_methods(),
                                             semant_errors(0) , 
                                             error_stream(cerr)
 {
@@ -135,6 +143,12 @@ ClassTable::ClassTable(Classes classes) : 	_classes(classes),
 		error_stream << "THROW ERROR! Graph is cyclic";
         semant_error();
 	}
+
+    // PASS 4 -- number the inheritance tree so subtype checks are O(1)
+    number_inheritance_tree();
+
+    // PASS 5 -- flatten inherited methods into one table per class
+    build_class_method_tables();
 	// RETURN SOME VALUE return is_cyclic;
 
 }
@@ -300,12 +314,6 @@ void ClassTable::add_class_methods_to_method_map(Class__class *curr_class)
 }
 
 
-std::map<std::pair<Symbol,Symbol>, std::vector<Symbol> >  ClassTable::get_method_map()
-{
-    return _method_map;
-}
-
-
  void ClassTable::install_basic_classes( ) {
 
     // The tree package uses these globals to annotate the classes built below.
@@ -455,16 +463,62 @@ ostream& ClassTable::semant_error(Class_ c)
 
 ostream& ClassTable::semant_error(Symbol filename, tree_node *t)
 {
-    error_stream << filename << ":" << t->get_line_number() << ": ";
+    get_error_stream() << filename << ":" << t->get_line_number() << ": ";
     return semant_error();
 }
 
 ostream& ClassTable::semant_error()                  
 {                                                 
+    if (class_errors) {
+        class_errors->count++;
+        return class_errors->text;
+    }
     semant_errors++;                            
     return error_stream;
 } 
 
+thread_local ClassErrors *ClassTable::class_errors = NULL;
+
+void ClassTable::merge_class_errors(ClassErrors & errors)
+{
+    error_stream << errors.text.str();
+    semant_errors += errors.count;
+}
+
+
+
+/*
+    Once the ClassTable, TypeEnv and ClassScopes are built they are only
+    read, and every class's bodies can be checked on their own. Worker
+    threads take the next unchecked class from a shared counter, check it
+    against a private copy of its class scope, and send its errors to that
+    class's buffer.
+*/
+struct SemantWork {
+    program_class *program;
+    const TypeEnv & env;
+    ClassScopes & class_scopes;
+    const std::vector<Symbol> & classes;
+    std::vector<ClassErrors> & errors;
+    std::atomic<size_t> next;
+
+    SemantWork(program_class *p, const TypeEnv & e, ClassScopes & s,
+               const std::vector<Symbol> & c, std::vector<ClassErrors> & errs)
+        : program(p), env(e), class_scopes(s), classes(c), errors(errs), next(0) { }
+};
+
+static void check_classes(SemantWork *work)
+{
+    for (size_t i = work->next++; i < work->classes.size(); i = work->next++)
+    {
+        Symbol curr_class_symbol = work->classes[i];
+        SymbolTable<Symbol,Symbol> class_symtab = work->class_scopes.scope_of(curr_class_symbol);
+
+        ClassTable::set_class_errors(&work->errors[i]);
+        work->program->verify_type_of_all_class_features(&class_symtab, work->env, curr_class_symbol);
+        ClassTable::set_class_errors(NULL);
+    }
+}
 
 
 /*   This is the entry point to the semantic checker.
@@ -489,11 +543,11 @@ void program_class::semant()
     /* ClassTable constructor may do some semantic analysis */
     ClassTable *classtable = new ClassTable(classes);
 
-    std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > method_map = classtable->get_method_map();
-    SymbolTable<Symbol,Symbol> *id_to_type_symtab = new SymbolTable<Symbol,Symbol>();
-    std::set<Symbol> valid_classes = classtable->get_class_set();
-    std::map<Symbol,Symbol> child_to_parent_classmap = classtable->get_child_map();
-    std::map<Symbol, Class_> declared_classes_map = classtable->get_class_map();
+    /* everything the type checker reads, shared by reference from here on */
+    const TypeEnv env(classtable);
+    const std::set<Symbol> & valid_classes = env.valid_classes;
+    const std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map = env.method_map;
+    ClassScopes class_scopes(env);
 
     // Add Object?, IO, Int, Str, and Bool to the child_to_parent_classmap
    
@@ -517,30 +571,37 @@ void program_class::semant()
 
 
     // Perform all type checking
-    for(std::set<Symbol>::iterator it = valid_classes.begin(); it != valid_classes.end(); it++)
+    std::vector<Symbol> classes_to_check;
+    for(std::set<Symbol>::const_iterator it = valid_classes.begin(); it != valid_classes.end(); it++)
     {
-
-
         Symbol curr_class_symbol = *it; 
         if (!(curr_class_symbol== Bool || curr_class_symbol == Str || curr_class_symbol == IO || curr_class_symbol == Object || *it == Int)){
-        Class__class *curr_class = declared_classes_map.find(curr_class_symbol)->second;
-         
-        verify_type_of_all_class_features(  id_to_type_symtab, 
-                                            method_map,
-                                            classtable, /* ostream& error_stream */
-                                            curr_class_symbol, 
-                                            child_to_parent_classmap,
-                                            declared_classes_map);
+            classes_to_check.push_back(curr_class_symbol);
         }
-         
     }
 
+    std::vector<ClassErrors> class_errors(classes_to_check.size());
+    SemantWork work(this, env, class_scopes, classes_to_check, class_errors);
+
+    unsigned num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) num_threads = 1;
+    if (num_threads > classes_to_check.size()) num_threads = classes_to_check.size();
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < num_threads; t++)
+        workers.push_back(std::thread(check_classes, &work));
+    check_classes(&work);
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    for (size_t i = 0; i < class_errors.size(); i++)
+        classtable->merge_class_errors(class_errors[i]);
+
     if (classtable->errors()) {
         cerr << "Compilation halted due to static semantic errors." << endl;
         exit(1);
     }
     // free the memory
-    delete id_to_type_symtab;
     delete classtable; // automatically frees the method table
 }
 
@@ -549,42 +610,17 @@ void program_class::semant()
     and while looping through each one, type check it individually.
 */
 void program_class::verify_type_of_all_class_features(  SymbolTable<Symbol,Symbol> *symtab,
-                                                        std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                                                        void* classtable, 
-                                                        Symbol curr_class_symbol, 
-                                                        std::map<Symbol,Symbol> & _child_to_parent_classmap,
-                                                        std::map<Symbol,Class_> & declared_classes_map)
+                                                        const TypeEnv & env,
+                                                        Symbol curr_class_symbol)
 {
 
-    list_node<Feature> *curr_features = (declared_classes_map.find(curr_class_symbol)->second)->get_features();
+    list_node<Feature> *curr_features = (env.declared_classes_map.find(curr_class_symbol)->second)->get_features();
     for(int i = curr_features->first(); curr_features->more(i); i = curr_features->next(i))
     {
 
+        // the class scope already holds self, the class names and every
+        // visible attribute; only the formals go into a fresh scope
         symtab->enterscope();
-std::set<Symbol> vlid_set = ((ClassTableP)(classtable))->get_class_set();
-for(std::set<Symbol>::iterator iter = vlid_set.begin(); iter != vlid_set.end(); iter++)
-    {
-            Symbol curr_class = *iter;
-            Symbol* address = new Symbol();
-            Symbol curr_type = curr_class;
-            *address = curr_type;
-            symtab->addid(curr_class, address);
-    }
-  
-    Symbol self_sym = SELF_TYPE;
-    Symbol* addr = new Symbol();
-    *addr  = self_sym;
-    symtab->addid(self, addr);
-
-add_own_attributes_to_scope(curr_class_symbol, declared_classes_map, symtab);
-       
-        add_parent_attributes_to_scope(_child_to_parent_classmap, 
-                                        declared_classes_map, 
-                                        curr_class_symbol,
-                                        symtab);
-
-
-
 
         Feature_class *curr_feat = curr_features->nth(i);
 
@@ -601,7 +637,6 @@ add_own_attributes_to_scope(curr_class_symbol, declared_classes_map, symtab);
             //add formals
 
 Formals formals_list = curr_feat->get_formals();
- std::vector<Symbol> true_formals = method_map.find(std::make_pair(curr_class_symbol, curr_feat->get_name()))->second; 
             
 
            
@@ -609,14 +644,10 @@ Formals formals_list = curr_feat->get_formals();
             for(int k = formals_list->first(); formals_list->more(k); k = formals_list->next(k)){
                 
                 Formal_class *forml = formals_list->nth(k);
-                Symbol* type_decl = new Symbol();
-                Symbol typ = *(forml->get_type_decl());
-                *type_decl  = typ;
-                Symbol name = forml->get_name();
-                symtab->addid(name, type_decl);
+                symtab->addid(forml->get_name(), forml->get_type_decl());
 
             }
-            Symbol method_type = (curr_feat->get_expression_to_check())->type_check(symtab, method_map, classtable, curr_class_symbol, _child_to_parent_classmap);
+            Symbol method_type = (curr_feat->get_expression_to_check())->type_check(symtab, env, curr_class_symbol);
                 //self type
             
             //if(method_type == SELF_TYPE ){
@@ -629,7 +660,7 @@ Formals formals_list = curr_feat->get_formals();
             
            //  ret_type = curr_class_symbol;
                 
-             //    if(((ClassTableP)classtable)->is_subtypeof(ret_type, method_type, _child_to_parent_classmap)){
+             //    if(env.classtable->is_subtypeof(ret_type, method_type, _child_to_parent_classmap)){
               //   ret_type = method_type;
 
               // }
@@ -643,16 +674,16 @@ Formals formals_list = curr_feat->get_formals();
 
             if(ret_type == SELF_TYPE){
                 ret_type = curr_class_symbol;
-                if(((ClassTableP)classtable)->is_subtypeof(ret_type, method_type, _child_to_parent_classmap)){
+                if(env.classtable->is_subtypeof(ret_type, method_type, curr_class_symbol)){
                     ret_type = method_type;
                 }
             }
 
 
 
-	 if ( !((ClassTableP)classtable)->is_subtypeof(method_type, ret_type, _child_to_parent_classmap) ){
-        ((ClassTableP)classtable)->get_error_stream() << "Inferred return type of method does not conform to declared return type."<<endl;
-        ((ClassTableP)classtable)->semant_error();
+	 if ( !env.classtable->is_subtypeof(method_type, ret_type, curr_class_symbol) ){
+        env.classtable->get_error_stream() << "Inferred return type of method does not conform to declared return type."<<endl;
+        env.classtable->semant_error();
        }
 	}
       
@@ -660,7 +691,7 @@ Formals formals_list = curr_feat->get_formals();
            
         } else {
             
-            Symbol attr_type = curr_feat->get_expression_to_check()->type_check(symtab, method_map, classtable, curr_class_symbol, _child_to_parent_classmap);
+            Symbol attr_type = curr_feat->get_expression_to_check()->type_check(symtab, env, curr_class_symbol);
 
         }
 
@@ -672,60 +703,62 @@ Formals formals_list = curr_feat->get_formals();
 }
 
 
-void program_class::add_own_attributes_to_scope(Symbol curr_class, 
-                                                std::map<Symbol,Class_> & declared_classes_map,
-                                                SymbolTable<Symbol,Symbol> *id_to_type_symtab)
+/*
+    The base table has one scope binding self and every class name. Each
+    class's table is its parent's table plus one scope with the class's own
+    attributes; since SymbolTable scopes are immutable lists, the copy
+    shares all of the parent's entries. The types the entries point to live
+    in _types, so nothing is allocated per lookup or per feature.
+*/
+ClassScopes::ClassScopes(const TypeEnv & env) : _scopes(), _types(), _base()
 {
-   
-    // loop over each feature
-    // if that feature is an attribute, add it to the symbol table
-    
-    list_node<Feature> *curr_features = (declared_classes_map.find(curr_class)->second)->get_features();
-    for(int i = curr_features->first(); curr_features->more(i); i = curr_features->next(i))
+    _base.enterscope();
+    for(std::set<Symbol>::const_iterator iter = env.valid_classes.begin(); iter != env.valid_classes.end(); iter++)
     {
-        Feature_class *curr_feat = curr_features->nth(i);
-        if (!curr_feat->feat_is_method() )
-        {
+        _types.push_back(*iter);
+        _base.addid(*iter, &_types.back());
+    }
+    _types.push_back(SELF_TYPE);
+    _base.addid(self, &_types.back());
 
-            Symbol* type_decl = new Symbol();
-            Symbol typ= *curr_feat->get_type_decl();
-            *type_decl  = typ;
+    for(std::map<Symbol,Class_>::const_iterator it = env.declared_classes_map.begin(); it != env.declared_classes_map.end(); it++)
+        build(env, it->first);
+}
 
-            
+SymbolTable<Symbol,Symbol> & ClassScopes::build(const TypeEnv & env, Symbol curr_class)
+{
+    std::map<Symbol, SymbolTable<Symbol,Symbol> >::iterator found = _scopes.find(curr_class);
+    if (found != _scopes.end())
+        return found->second;
 
-            id_to_type_symtab->addid( curr_feat->get_name(), type_decl );
-        } 
+    // entered before recursing, so a cyclic parent chain stops at the base table
+    SymbolTable<Symbol,Symbol> & table = _scopes[curr_class] = _base;
+
+    std::map<Symbol,Symbol>::const_iterator parent = env.child_to_parent_classmap.find(curr_class);
+    if (curr_class != Object && parent != env.child_to_parent_classmap.end() &&
+        env.declared_classes_map.find(parent->second) != env.declared_classes_map.end())
+    {
+        table = build(env, parent->second);
     }
-}
 
-void program_class::add_parent_attributes_to_scope(std::map<Symbol,Symbol> & child_to_parent_classmap, 
-                                    std::map<Symbol,Class_> & declared_classes_map,
-                                    Symbol curr_class,
-                                    SymbolTable<Symbol,Symbol> *id_to_type_symtab)
-{
-   
-    // get the first parent
-    if(curr_class!=Object){
-    Symbol parent = (child_to_parent_classmap.find(curr_class))->second;
-    while( true ){
-        // get the parent's features
-        if(declared_classes_map.find(parent)==declared_classes_map.end()) break;
-        list_node<Feature> *curr_features = (declared_classes_map.find(parent)->second)->get_features();
-        for(int i = curr_features->first(); curr_features->more(i); i = curr_features->next(i))
+    table.enterscope();
+    list_node<Feature> *curr_features = (env.declared_classes_map.find(curr_class)->second)->get_features();
+    for(int i = curr_features->first(); curr_features->more(i); i = curr_features->next(i))
+    {
+        Feature_class *curr_feat = curr_features->nth(i);
+        if (!curr_feat->feat_is_method() )
         {
-            Feature_class *curr_feat = curr_features->nth(i);
-            if (!curr_feat->feat_is_method() )
-            {
-
-                Symbol* type_decl = new Symbol();
-            Symbol typ= *curr_feat->get_type_decl();
-            *type_decl  = typ;
-                id_to_type_symtab->addid( curr_feat->get_name(), type_decl );
-            } 
+            _types.push_back(curr_feat->get_type_decl());
+            table.addid(curr_feat->get_name(), &_types.back());
         }
-        parent = child_to_parent_classmap.find(parent)->second;
     }
+    return table;
 }
+
+SymbolTable<Symbol,Symbol> ClassScopes::scope_of(Symbol curr_class)
+{
+    std::map<Symbol, SymbolTable<Symbol,Symbol> >::iterator found = _scopes.find(curr_class);
+    return found == _scopes.end() ? _base : found->second;
 }
 
 
@@ -840,51 +873,48 @@ bool ClassTable::check_inheritance_graph_for_cycles()
 
 
 
-Symbol *method_class::get_type_decl()
-{
-    return &Object;
-}
-
-
-Symbol static_dispatch_class::type_check(   SymbolTable<Symbol,Symbol> *symtab,
-                                            std::map<std::pair<Symbol,Symbol>,
-                                            std::vector<Symbol> > & method_map,
-                                            void* classtable, 
-                                            Symbol class_symbol, 
-                                            std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol static_dispatch_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
      bool disp_was_self = false;
     //must conform to the type as type_name
-    Symbol dispatch_class = expr->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap); 
+    Symbol dispatch_class = expr->type_check(symtab, env, class_symbol); 
    
     if(dispatch_class == SELF_TYPE){
         disp_was_self = true;
         dispatch_class = class_symbol;
    }
 
-    if ( !is_subtypeof(dispatch_class, type_name, _child_to_parent_classmap) ){
-        ((ClassTableP)classtable)->get_error_stream() << "Static dispatch class did not conform."<<endl;
-        ((ClassTableP)classtable)->semant_error();
+    if ( !env.classtable->is_subtypeof(dispatch_class, type_name, class_symbol) ){
+        env.classtable->get_error_stream() << "Static dispatch class did not conform."<<endl;
+        env.classtable->semant_error();
+    }
+    const std::vector<Symbol> *signature = env.classtable->lookup_method(type_name, name);
+    if (signature == NULL)
+    {
+        env.classtable->get_error_stream() << "No matching method declaration."<<endl;
+        env.classtable->semant_error();
+        return Object;
     }
-    std::vector<Symbol> method_formals = method_map.find(std::make_pair(type_name, name))->second; 
+    const std::vector<Symbol> & method_formals = *signature;
     std::vector<Symbol> dispatch_formals; 
     for(int i = actual->first(); actual->more(i); i = actual->next(i))
     {
-        dispatch_formals.push_back(actual->nth(i)->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap));
+        dispatch_formals.push_back(actual->nth(i)->type_check(symtab, env, class_symbol));
     }
     // check number of args is right -- we added return type to method_formals
     if (dispatch_formals.size() != (method_formals.size()-1) )
     {
-        ((ClassTableP)classtable)->get_error_stream() << "You tried to call a function, but didnt supply the right number of args."<<endl;
-        ((ClassTableP)classtable)->semant_error();
+        env.classtable->get_error_stream() << "You tried to call a function, but didnt supply the right number of args."<<endl;
+        env.classtable->semant_error();
+        return Object;
 
     }
     for( size_t j = 0; j < dispatch_formals.size(); j++ )
     {
         //check that used dispatch formal is a subtype of declared method formal
-        if ( !is_subtypeof(dispatch_formals[j], method_formals[j], _child_to_parent_classmap) ){
-            ((ClassTableP)classtable)->get_error_stream() << "Dispatch formal did not conform."<<endl;
-            ((ClassTableP)classtable)->semant_error();
+        if ( !env.classtable->is_subtypeof(dispatch_formals[j], method_formals[j], class_symbol) ){
+            env.classtable->get_error_stream() << "Dispatch formal did not conform."<<endl;
+            env.classtable->semant_error();
         }
     }
 
@@ -907,63 +937,36 @@ Symbol static_dispatch_class::type_check(   SymbolTable<Symbol,Symbol> *symtab,
     Normal dispatch has args:
         (Expression expr, Symbol name, Expressions actual;)
 */
-Symbol dispatch_class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
-                                    std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                                    void* classtable, 
-                                    Symbol class_symbol, 
-                                    std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol dispatch_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
     bool disp_was_self = false;
     //must conform to the type as type_name
-    Symbol dispatch_class = expr->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap); 
+    Symbol dispatch_class = expr->type_check(symtab, env, class_symbol); 
    if(dispatch_class == SELF_TYPE){
     disp_was_self = true;
     dispatch_class = class_symbol;
    }
-    std::map<Symbol, Class_> declared_classes_map = ((ClassTableP)classtable)->get_class_map();
-    std::vector<Symbol> method_formals;
-    Symbol disp_class = dispatch_class;
-
-    if(method_map.find(std::make_pair(dispatch_class, name)) == method_map.end()){
-
-    while(true){
-
-        if(_child_to_parent_classmap.find(disp_class) == _child_to_parent_classmap.end()){
-            //no parents
-        ((ClassTableP)classtable)->get_error_stream() << "No matching method declaration."<<endl;
-        ((ClassTableP)classtable)->semant_error();
+    const std::vector<Symbol> *signature = env.classtable->lookup_method(dispatch_class, name);
+    if (signature == NULL)
+    {
+        env.classtable->get_error_stream() << "No matching method declaration."<<endl;
+        env.classtable->semant_error();
         return Object;
-
-        }
-        //get parent
-        Symbol disp_parent = (_child_to_parent_classmap).find(disp_class)->second; 
-
-
-        if(method_map.find(std::make_pair(disp_parent, name)) != method_map.end()){
-            method_formals = method_map.find(std::make_pair(disp_parent, name))->second;
-            break;
-        }
-
-        disp_class = disp_parent;
-    }
-
-}else{
-        method_formals = method_map.find(std::make_pair(dispatch_class, name))->second;
-
     }
+    const std::vector<Symbol> & method_formals = *signature;
 
 
     std::vector<Symbol> dispatch_formals; 
     for(int i = actual->first(); actual->more(i); i = actual->next(i))
     {
 
-        dispatch_formals.push_back(actual->nth(i)->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap));
+        dispatch_formals.push_back(actual->nth(i)->type_check(symtab, env, class_symbol));
     }
     // check number of args is right -- we added return type to method_formals
     if (dispatch_formals.size() != (method_formals.size()-1) )
     {
-        ((ClassTableP)classtable)->get_error_stream() << "You tried to call a function, but didnt supply the right number of args."<<endl;
-        ((ClassTableP)classtable)->semant_error();
+        env.classtable->get_error_stream() << "You tried to call a function, but didnt supply the right number of args."<<endl;
+        env.classtable->semant_error();
         return Object;
 
     }
@@ -973,9 +976,9 @@ Symbol dispatch_class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
             dispatch_formals[j]= class_symbol;
         }
         //check that used dispatch formal is a subtype of declared method formal
-        if ( !is_subtypeof(dispatch_formals[j], method_formals[j], _child_to_parent_classmap) ){
-            ((ClassTableP)classtable)->get_error_stream() << "Dispatch formal did not conform."<<endl;
-            ((ClassTableP)classtable)->semant_error();
+        if ( !env.classtable->is_subtypeof(dispatch_formals[j], method_formals[j], class_symbol) ){
+            env.classtable->get_error_stream() << "Dispatch formal did not conform."<<endl;
+            env.classtable->semant_error();
             return Object;
         }
     }
@@ -998,17 +1001,15 @@ Symbol dispatch_class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
 } 
 
 
-Symbol loop_class::type_check(     SymbolTable<Symbol,Symbol> *symtab,
-                    std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                    void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol loop_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
-  if ( pred->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap) != Bool )
+  if ( pred->type_check(symtab, env, class_symbol) != Bool )
   {
-     ((ClassTableP)classtable)->get_error_stream() << "You did not use a boolean predicate for the while loop"<<endl;
-     ((ClassTableP)classtable)->semant_error();
+     env.classtable->get_error_stream() << "You did not use a boolean predicate for the while loop"<<endl;
+     env.classtable->semant_error();
   }
 
- body->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap); 
+ body->type_check(symtab, env, class_symbol); 
 
   type = Object;
   return Object;
@@ -1016,15 +1017,13 @@ Symbol loop_class::type_check(     SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol plus_class::type_check(     SymbolTable<Symbol,Symbol> *symtab,
-                    std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                    void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol plus_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
 
-  if(! (	(e1->type_check(symtab,method_map, classtable, class_symbol, _child_to_parent_classmap) == Int) 
-	&& (e2 ->type_check(symtab,method_map, classtable, class_symbol, _child_to_parent_classmap) == Int))	 ){
-  ((ClassTableP)classtable)->get_error_stream() << "Attempted to add two non-integers"<<endl;
-   ((ClassTableP)classtable)->semant_error();
+  if(! (	(e1->type_check(symtab, env, class_symbol) == Int) 
+	&& (e2 ->type_check(symtab, env, class_symbol) == Int))	 ){
+  env.classtable->get_error_stream() << "Attempted to add two non-integers"<<endl;
+   env.classtable->semant_error();
   }
 
   type = Int;
@@ -1032,16 +1031,14 @@ Symbol plus_class::type_check(     SymbolTable<Symbol,Symbol> *symtab,
 }
 
 
-Symbol sub_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                    std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                    void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol sub_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
 
-  if(! (    (e1->type_check(symtab,method_map,classtable,class_symbol, _child_to_parent_classmap) == Int)
-            && (e2 ->type_check(symtab,method_map,classtable,class_symbol, _child_to_parent_classmap) == Int))     ){
+  if(! (    (e1->type_check(symtab, env, class_symbol) == Int)
+            && (e2 ->type_check(symtab, env, class_symbol) == Int))     ){
      //error
-    ((ClassTableP)classtable)->get_error_stream() << "Attempted to subtract two non-integers"<<endl;
-    ((ClassTableP)classtable)->semant_error(); 
+    env.classtable->get_error_stream() << "Attempted to subtract two non-integers"<<endl;
+    env.classtable->semant_error(); 
   }
   type = Int;
 
@@ -1051,19 +1048,15 @@ Symbol sub_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol isvoid_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                    std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                    void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol isvoid_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
-  e1->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap); 
+  e1->type_check(symtab, env, class_symbol); 
   type = Bool;
   return Bool;
 }
 
 
-Symbol no_expr_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                    std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                    void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol no_expr_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
 
     type = No_type;
@@ -1074,17 +1067,15 @@ Symbol no_expr_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol mul_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                    std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                    void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol mul_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
 
 
-  if(! (    (e1->type_check(symtab,method_map,classtable, class_symbol, _child_to_parent_classmap) == Int)
-            && (e2 ->type_check(symtab,method_map,classtable, class_symbol, _child_to_parent_classmap) == Int))     ){
+  if(! (    (e1->type_check(symtab, env, class_symbol) == Int)
+            && (e2 ->type_check(symtab, env, class_symbol) == Int))     ){
      //error
-    ((ClassTableP)classtable)->get_error_stream() << "Attempted to multiply two non-integers"<<endl;
-    ((ClassTableP)classtable)->semant_error();
+    env.classtable->get_error_stream() << "Attempted to multiply two non-integers"<<endl;
+    env.classtable->semant_error();
   }
 
   type = Int;
@@ -1092,16 +1083,14 @@ Symbol mul_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
 }
 
 
- Symbol divide_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                        std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                        void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+ Symbol divide_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
 
-  if(! (    (e1->type_check(symtab,method_map,classtable, class_symbol, _child_to_parent_classmap) == Int)
-            && (e2 ->type_check(symtab,method_map,classtable, class_symbol, _child_to_parent_classmap) == Int))     ){
+  if(! (    (e1->type_check(symtab, env, class_symbol) == Int)
+            && (e2 ->type_check(symtab, env, class_symbol) == Int))     ){
      //error
-    ((ClassTableP)classtable)->get_error_stream() << "Attempted to add two non-integers"<<endl;
-    ((ClassTableP)classtable)->semant_error();
+    env.classtable->get_error_stream() << "Attempted to add two non-integers"<<endl;
+    env.classtable->semant_error();
 
   }
 
@@ -1110,15 +1099,13 @@ Symbol mul_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
 }
 
 
- Symbol neg_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                        std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                       void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+ Symbol neg_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
 
-  if(! (e1->type_check(symtab,method_map,classtable, class_symbol, _child_to_parent_classmap) == Int) ){
+  if(! (e1->type_check(symtab, env, class_symbol) == Int) ){
      //error
-     ((ClassTableP)classtable)->get_error_stream() << "You tried to negate a non-integer"<<endl;
-     ((ClassTableP)classtable)->semant_error();
+     env.classtable->get_error_stream() << "You tried to negate a non-integer"<<endl;
+     env.classtable->semant_error();
 
   }
 
@@ -1127,16 +1114,11 @@ Symbol mul_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
 }
 
 
-Symbol lt_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                            std::map<std::pair<Symbol,Symbol>,
-                            std::vector<Symbol> > & method_map,
-                            void* classtable, 
-                            Symbol class_symbol, 
-                            std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol lt_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
-    if(! (((e1-> type_check(symtab,method_map,classtable, class_symbol, _child_to_parent_classmap)) == Int) && ((e2 -> type_check(symtab,method_map,classtable, class_symbol, _child_to_parent_classmap)) == Int))){
-        ((ClassTableP)classtable)->get_error_stream() << "Attempted to compare two non-integers"<<endl;
-        ((ClassTableP)classtable)->semant_error();
+    if(! (((e1-> type_check(symtab, env, class_symbol)) == Int) && ((e2 -> type_check(symtab, env, class_symbol)) == Int))){
+        env.classtable->get_error_stream() << "Attempted to compare two non-integers"<<endl;
+        env.classtable->semant_error();
     }
     type = Bool;
     return Bool;
@@ -1144,29 +1126,24 @@ Symbol lt_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol eq_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                            std::map<std::pair<Symbol,Symbol>,
-                            std::vector<Symbol> > & method_map,
-                            void* classtable, 
-                            Symbol class_symbol, 
-                            std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol eq_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
-    Symbol T1 = e1->type_check( symtab, method_map, classtable, class_symbol,_child_to_parent_classmap);
-    Symbol T2 = e2->type_check( symtab, method_map,  classtable, class_symbol, _child_to_parent_classmap);
+    Symbol T1 = e1->type_check(symtab, env, class_symbol);
+    Symbol T2 = e2->type_check(symtab, env, class_symbol);
 
     if ( ((T1 == Bool) && (T2 != Bool)) || ((T2 == Bool) && (T1 != Bool)) ){
-        ((ClassTableP)classtable)->get_error_stream() << "You tried to check different types for equality."<<endl;
-        ((ClassTableP)classtable)->semant_error();
+        env.classtable->get_error_stream() << "You tried to check different types for equality."<<endl;
+        env.classtable->semant_error();
     }
     if ( ((T1 == Int) && (T2 != Int)) || ((T2 == Int) && (T1 != Int)) )
     {
-       ((ClassTableP)classtable)->get_error_stream() << "You tried to check different types for equality v bad"<<endl;
-        ((ClassTableP)classtable)->semant_error();
+       env.classtable->get_error_stream() << "You tried to check different types for equality v bad"<<endl;
+        env.classtable->semant_error();
     }
     if ( ((T1 == Str) && (T2 != Str)) || ((T2 == Str) && (T1 != Str)) )
     {
-        ((ClassTableP)classtable)->get_error_stream() << "You tried to check different types for equality v bad"<<endl;
-        ((ClassTableP)classtable)->semant_error();
+        env.classtable->get_error_stream() << "You tried to check different types for equality v bad"<<endl;
+        env.classtable->semant_error();
     }
     type = Bool;
     return Bool;
@@ -1174,38 +1151,29 @@ Symbol eq_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol leq_class::type_check(    SymbolTable<Symbol,Symbol> *symtab,
-                            std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                            void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol leq_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
-    if(! (((e1-> type_check(symtab,method_map, classtable, class_symbol, _child_to_parent_classmap)) == Int) && ((e2 -> type_check(symtab,method_map,classtable, class_symbol, _child_to_parent_classmap)) == Int))){
-        ((ClassTableP)classtable)->get_error_stream() << "Attempted to compare two non-integers"<<endl;
-        ((ClassTableP)classtable)->semant_error();
+    if(! (((e1-> type_check(symtab, env, class_symbol)) == Int) && ((e2 -> type_check(symtab, env, class_symbol)) == Int))){
+        env.classtable->get_error_stream() << "Attempted to compare two non-integers"<<endl;
+        env.classtable->semant_error();
     }
     type = Bool;
     return Bool;
 }
 
 
-Symbol comp_class::type_check(	SymbolTable<Symbol,Symbol> *symtab,
-                            std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                            void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol comp_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
-    if( ( e1->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap) != Bool ) ) {
-        ((ClassTableP)classtable)->get_error_stream() << "Attempted to get complement of a non Bool."<<endl;
-        ((ClassTableP)classtable)->semant_error();
+    if( ( e1->type_check(symtab, env, class_symbol) != Bool ) ) {
+        env.classtable->get_error_stream() << "Attempted to get complement of a non Bool."<<endl;
+        env.classtable->semant_error();
     }
     type = Bool;
     return Bool;
 }
 
 
-Symbol string_const_class::type_check(	SymbolTable<Symbol,Symbol> *symtab,
-                                        std::map<std::pair<Symbol,Symbol>,
-                                        std::vector<Symbol> > & method_map,
-                                        void* classtable,
-                                        Symbol class_symbol, 
-                                        std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol string_const_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
     type = Str;
     return Str; 
@@ -1216,12 +1184,7 @@ Symbol string_const_class::type_check(	SymbolTable<Symbol,Symbol> *symtab,
 /*
 	When "new <type>" is defined, we return <type>
 */
-Symbol new__class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
-                                std::map<std::pair<Symbol,Symbol>,
-                                std::vector<Symbol> > & method_map,
-                                void* classtable, 
-                                Symbol class_symbol, 
-                                std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol new__class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 
 {
     type = type_name;
@@ -1230,12 +1193,7 @@ Symbol new__class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol object_class::type_check(    SymbolTable<Symbol,Symbol> *symtab,
-                                    std::map<std::pair<Symbol,Symbol>,
-                                    std::vector<Symbol> > & method_map,
-                                    void* classtable, 
-                                    Symbol class_symbol, 
-                                    std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol object_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
     
     
@@ -1243,8 +1201,8 @@ Symbol object_class::type_check(    SymbolTable<Symbol,Symbol> *symtab,
 
     if( type_of_ID == NULL)
     {
-        ((ClassTableP)classtable)->get_error_stream() << "This variable name was never defined"<<endl;
-        ((ClassTableP)classtable)->semant_error();
+        env.classtable->get_error_stream() << "This variable name was never defined"<<endl;
+        env.classtable->semant_error();
         type = Object;
     } else {
         type = *type_of_ID;
@@ -1256,12 +1214,7 @@ Symbol object_class::type_check(    SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol bool_const_class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
-                                    std::map<std::pair<Symbol,Symbol>,
-                                    std::vector<Symbol> > & method_map,
-                                    void* classtable, 
-                                    Symbol class_symbol, 
-                                    std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol bool_const_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
     type = Bool;
     return type;
@@ -1269,11 +1222,7 @@ Symbol bool_const_class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol int_const_class::type_check(   SymbolTable<Symbol,Symbol> *symtab,
-                                    std::map<std::pair<Symbol,Symbol>,
-                                    std::vector<Symbol> > & method_map,
-                                    void* classtable,Symbol class_symbol, 
-                                    std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol int_const_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
     type = Int;
     return type;
@@ -1284,30 +1233,22 @@ Symbol int_const_class::type_check(   SymbolTable<Symbol,Symbol> *symtab,
 	We enforce that 
 		e1 is a subtype of T0
 */
-Symbol let_class::type_check( SymbolTable<Symbol,Symbol> *symtab,
-                            std::map<std::pair<Symbol,Symbol>,
-                            std::vector<Symbol> > & method_map,
-                            void* classtable, 
-                            Symbol class_symbol, 
-                            std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol let_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
     
-    Symbol initType = init->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap);
+    Symbol initType = init->type_check(symtab, env, class_symbol);
     if(initType== No_type){ initType = type_decl;}
     if(initType== SELF_TYPE){ initType = type_decl;}
-    if( !is_subtypeof(initType, type_decl, _child_to_parent_classmap) )
+    if( !env.classtable->is_subtypeof(initType, type_decl, class_symbol) )
     {
-        ((ClassTableP)classtable)->get_error_stream() << "the let initialization was not a subtype of the declared type of the var"<<endl;
-        ((ClassTableP)classtable)->semant_error();
+        env.classtable->get_error_stream() << "the let initialization was not a subtype of the declared type of the var"<<endl;
+        env.classtable->semant_error();
     }
 
     symtab->enterscope(); 
     
-    Symbol* address = new Symbol();
-    Symbol curr_type = type_decl;
-    *address = curr_type;
-    symtab->addid(identifier, address); // add x temporarily to the symbol table
-    Symbol bodyType = body->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap);
+    symtab->addid(identifier, &type_decl); // add x temporarily to the symbol table
+    Symbol bodyType = body->type_check(symtab, env, class_symbol);
     symtab->exitscope(); // x is removed from the symbol table
     type = bodyType; 
     return type;
@@ -1317,14 +1258,12 @@ Symbol let_class::type_check( SymbolTable<Symbol,Symbol> *symtab,
 /*
     Only field is "Expressions body"
 */
-Symbol block_class::type_check( SymbolTable<Symbol,Symbol> *symtab,
-                                std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                                void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol block_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
     int num_exprs_in_block = body->len();
     for(int i = body->first(); body->more(i); i = body->next(i))
     {
-        Symbol curr_expr_type = body->nth(i)->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap);
+        Symbol curr_expr_type = body->nth(i)->type_check(symtab, env, class_symbol);
         // type of a block is the value of the last expression
        
             type = curr_expr_type;
@@ -1336,11 +1275,9 @@ Symbol block_class::type_check( SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol typcase_class::type_check( SymbolTable<Symbol,Symbol> *symtab,
-                                std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                                void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol typcase_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
-        expr->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap);
+        expr->type_check(symtab, env, class_symbol);
         std::list<Symbol> types;
         Symbol return_case; 
      for(int i = cases->first(); cases->more(i); i = cases->next(i)){
@@ -1348,11 +1285,10 @@ Symbol typcase_class::type_check( SymbolTable<Symbol,Symbol> *symtab,
         symtab->enterscope();
 
     
-    Symbol* address = new Symbol();
+    // the entry is unreachable after exitscope, so a local can back it
     Symbol curr_type = cases->nth(i)->get_type_decl();
-    *address = curr_type;
-    symtab->addid(cases->nth(i)->get_name(), address); // add x temporarily to the symbol table
-    Symbol case_type = cases->nth(i)->get_expr()->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap);
+    symtab->addid(cases->nth(i)->get_name(), &curr_type); // add x temporarily to the symbol table
+    Symbol case_type = cases->nth(i)->get_expr()->type_check(symtab, env, class_symbol);
     types.push_back(case_type);
     symtab->exitscope(); // x is r
        
@@ -1362,9 +1298,9 @@ Symbol typcase_class::type_check( SymbolTable<Symbol,Symbol> *symtab,
         return types.front();
     }else{
       std::list<Symbol>::iterator it;
-      return_case = least_upper_bound(types.front(),types.front(), class_symbol,  _child_to_parent_classmap );
+      return_case = types.front();
     for (it = types.begin(); it != types.end(); ++it){
-        return_case = least_upper_bound(return_case, *it, class_symbol, _child_to_parent_classmap );
+        return_case = env.classtable->least_upper_bound(return_case, *it, class_symbol);
     }
 }
     type = return_case;
@@ -1373,40 +1309,34 @@ Symbol typcase_class::type_check( SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol cond_class::type_check(SymbolTable<Symbol,Symbol> *symtab,
-                            std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                            void* classtable, Symbol class_symbol, std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol cond_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
 
-    if ( !(pred->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap) == Bool) )
+    if ( !(pred->type_check(symtab, env, class_symbol) == Bool) )
     {
-        ((ClassTableP)classtable)->get_error_stream() << "You use a conditional (if/then/else) without a boolean predicate"<<endl;
-        ((ClassTableP)classtable)->semant_error();
+        env.classtable->get_error_stream() << "You use a conditional (if/then/else) without a boolean predicate"<<endl;
+        env.classtable->semant_error();
     }
-    Symbol e1_type = then_exp->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap);
-    Symbol e2_type = else_exp->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap);
-    type = least_upper_bound (e1_type, e2_type, class_symbol, _child_to_parent_classmap);
+    Symbol e1_type = then_exp->type_check(symtab, env, class_symbol);
+    Symbol e2_type = else_exp->type_check(symtab, env, class_symbol);
+    type = env.classtable->least_upper_bound(e1_type, e2_type, class_symbol);
     return type;
 }
 
 
-Symbol assign_class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
-                                std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map,
-                                void* classtable, 
-                                Symbol class_symbol, 
-                                std::map<Symbol,Symbol> _child_to_parent_classmap)
+Symbol assign_class::type_check(SymbolTable<Symbol,Symbol> *symtab, const TypeEnv & env, Symbol class_symbol)
 {
     Symbol *enforced_type_of_ID = symtab->lookup(name); // check if "Id" is defined 
     if( enforced_type_of_ID == NULL)
     {
-        ((ClassTableP)classtable)->get_error_stream() << "ID missing in symtab: You cannot assign a variable that was not declared as a class attribute"<<endl;
-        ((ClassTableP)classtable)->semant_error();
+        env.classtable->get_error_stream() << "ID missing in symtab: You cannot assign a variable that was not declared as a class attribute"<<endl;
+        env.classtable->semant_error();
     }
-    Symbol found_expr_type = expr->type_check(symtab, method_map, classtable, class_symbol, _child_to_parent_classmap);
+    Symbol found_expr_type = expr->type_check(symtab, env, class_symbol);
 
-    if ( !is_subtypeof(found_expr_type, *enforced_type_of_ID, _child_to_parent_classmap) ){
-        ((ClassTableP)classtable)->get_error_stream() << "Assign class did not conform."<<endl;
-        ((ClassTableP)classtable)->semant_error();
+    if ( !env.classtable->is_subtypeof(found_expr_type, *enforced_type_of_ID, class_symbol) ){
+        env.classtable->get_error_stream() << "Assign class did not conform."<<endl;
+        env.classtable->semant_error();
     }
     type = found_expr_type; 
     return type;
@@ -1416,108 +1346,149 @@ Symbol assign_class::type_check(  SymbolTable<Symbol,Symbol> *symtab,
 
 
 
-Symbol Expression_class::least_upper_bound (Symbol symbol1, 
-                                            Symbol symbol2, 
-                                            Symbol class_symbol, 
-                                            std::map<Symbol,Symbol> _child_to_parent_classmap)
+/*
+    The inheritance tree is numbered once by a depth first walk from Object.
+    Every class gets the interval [preorder, postorder] of its subtree, so
+    child <= parent exactly when the child's interval lies inside the
+    parent's. Classes off the tree (undefined parents, cycles) get no
+    index and conform to nothing but themselves and Object.
+
+    _ancestor[k][i] is the 2^k-th ancestor of class i (Object is its own
+    parent), which lets least_upper_bound climb in O(log depth) steps.
+*/
+void ClassTable::number_inheritance_tree()
 {
-    
-    if(symbol1 == symbol2) return symbol1;
-    if(symbol1 == SELF_TYPE && symbol2 == SELF_TYPE) return SELF_TYPE;
-    if(symbol1 == SELF_TYPE && symbol2 != SELF_TYPE) symbol1 = class_symbol;
-    if(symbol2 == SELF_TYPE && symbol1 != SELF_TYPE) symbol2 = class_symbol;
-
-    std::list<Symbol> parents1; 
-    parents1.push_back(symbol1);
-     if(_child_to_parent_classmap.find(symbol1)!=_child_to_parent_classmap.end()){
-    Symbol parent1 = _child_to_parent_classmap.find(symbol1)->second;
+    std::map<Symbol, std::vector<Symbol> > children;
+    for (std::map<Symbol, Symbol>::iterator it = _child_to_parent_classmap.begin(); it != _child_to_parent_classmap.end(); ++it)
+    {
+        if (it->first != Object)
+            children[it->second].push_back(it->first);
+    }
 
-    while(true){
+    _ancestor.push_back(std::vector<int>());
+    int counter = 0;
+    number_class(Object, 0, children, counter);
 
-        parents1.push_back(parent1);
-        if(_child_to_parent_classmap.find(parent1) == _child_to_parent_classmap.end()){
-            break;
-        }
-        parent1 = (_child_to_parent_classmap).find(parent1)->second;  
+    int num_classes = _tree_class.size();
+    for (int k = 1; (1 << k) < num_classes; k++)
+    {
+        std::vector<int> & half = _ancestor[k-1];
+        std::vector<int> level(num_classes);
+        for (int i = 0; i < num_classes; i++)
+            level[i] = half[half[i]];
+        _ancestor.push_back(level);
     }
-    
+}
+
+void ClassTable::number_class(  Symbol curr_class,
+                                int parent_index,
+                                std::map<Symbol, std::vector<Symbol> > & children,
+                                int & counter )
+{
+    int index = _tree_class.size();
+    _tree_index[curr_class] = index;
+    _tree_class.push_back(curr_class);
+    _ancestor[0].push_back(parent_index);
+    _preorder.push_back(counter++);
+    _postorder.push_back(0);
+
+    std::map<Symbol, std::vector<Symbol> >::iterator kids = children.find(curr_class);
+    if (kids != children.end())
+    {
+        for (size_t i = 0; i < kids->second.size(); i++)
+            number_class(kids->second[i], index, children, counter);
     }
+    _postorder[index] = counter++;
+}
 
-    if(_child_to_parent_classmap.find(symbol2)!=_child_to_parent_classmap.end()){
-    Symbol parent2 = symbol2;
+/*
+    _tree_class is in preorder, so every class comes after its parent and
+    can start from a copy of the parent's table. A method a class defines
+    replaces the inherited entry, and must keep the inherited signature:
+    same number of formals, same formal types and same return type.
+*/
+void ClassTable::build_class_method_tables()
+{
+    _class_methods.resize(_tree_class.size());
+    for (size_t i = 0; i < _tree_class.size(); i++)
+    {
+        Symbol curr_class = _tree_class[i];
+        std::map<Symbol, const std::vector<Symbol> *> & methods = _class_methods[i];
+        if (i != 0)
+            methods = _class_methods[_ancestor[0][i]];
+
+        Class_ class_node = _declared_classes_map.find(curr_class)->second;
+        list_node<Feature> *curr_features = class_node->get_features();
+        for(int j = curr_features->first(); curr_features->more(j); j = curr_features->next(j))
+        {
+            Feature_class *curr_feat = curr_features->nth(j);
+            if (!curr_feat->feat_is_method())
+                continue;
 
-    while(true){
-        std::list<Symbol>::iterator it;
-        for (it = parents1.begin(); it != parents1.end(); ++it){
-            if(parent2 == *it)
+            const std::vector<Symbol> *own = &_method_map.find(std::make_pair(curr_class, curr_feat->get_name()))->second;
+            std::map<Symbol, const std::vector<Symbol> *>::iterator inherited = methods.find(curr_feat->get_name());
+            if (inherited != methods.end() && inherited->second != own && *inherited->second != *own)
             {
-                return parent2;
+                semant_error(class_node->get_filename(), curr_feat) << "Method " << curr_feat->get_name()
+                    << " does not match the signature of the method it overrides." << endl;
             }
+            methods[curr_feat->get_name()] = own;
         }
-        if(_child_to_parent_classmap.find(parent2) == _child_to_parent_classmap.end()){
-            break;
-        }
-        parent2 = _child_to_parent_classmap.find(parent2)->second;
     }
 }
-    return Object; 
-}
 
-
-bool Expression_class::is_subtypeof(  Symbol child, Symbol supposed_parent, 
-                                        std::map<Symbol,Symbol> _child_to_parent_classmap )
+const std::vector<Symbol> *ClassTable::lookup_method(Symbol class_name, Symbol method_name)
 {
-     if (child == supposed_parent) return true;
-    if (supposed_parent == Object ) return true;
+    std::map<Symbol,int>::iterator index = _tree_index.find(class_name);
+    if (index == _tree_index.end()) return NULL;
 
-    // if the child is Object, the only way to get subtype_of is if the 
-    // parent is also an object
-    if ( (child==Object) && (supposed_parent != Object)) return false;
-    
-    std::list<Symbol> real_parents; 
-    if(_child_to_parent_classmap.find(child)!=_child_to_parent_classmap.end()){
-    Symbol real_parent = _child_to_parent_classmap.find(child)->second;
-    while(true){
-        real_parents.push_back(real_parent);
-        if((_child_to_parent_classmap).find(real_parent)== _child_to_parent_classmap.end()){
-            break;
-        }
-        real_parent = (_child_to_parent_classmap).find(real_parent)->second;  
-    }
-    }
-    std::list<Symbol>::iterator it;
-    for (it = real_parents.begin(); it != real_parents.end(); ++it){
-        Symbol found_parent = *it; 
-        if ( found_parent == supposed_parent) return true;
-    }
-    return false;
+    std::map<Symbol, const std::vector<Symbol> *> & methods = _class_methods[index->second];
+    std::map<Symbol, const std::vector<Symbol> *>::iterator found = methods.find(method_name);
+    return found == methods.end() ? NULL : found->second;
 }
 
-bool ClassTable::is_subtypeof(  Symbol child, Symbol supposed_parent, 
-                                        std::map<Symbol,Symbol> _child_to_parent_classmap )
+/*
+    SELF_TYPE is handled before the interval test: SELF_TYPE conforms to T
+    when the enclosing class does, and only SELF_TYPE conforms to SELF_TYPE.
+*/
+bool ClassTable::is_subtypeof(Symbol child, Symbol supposed_parent, Symbol class_symbol)
 {
     if (child == supposed_parent) return true;
-    if (supposed_parent == Object ) return true;
+    if (supposed_parent == SELF_TYPE) return false;
+    if (child == SELF_TYPE) child = class_symbol;
+    if (supposed_parent == Object) return true;
 
-    // if the child is Object, the only way to get subtype_of is if the 
-    // parent is also an object
-    if ( (child==Object) && (supposed_parent != Object)) return false;
-    
-    std::list<Symbol> real_parents; 
-    if(_child_to_parent_classmap.find(child)!=_child_to_parent_classmap.end()){
-    Symbol real_parent = _child_to_parent_classmap.find(child)->second;
-    while(true){
-        real_parents.push_back(real_parent);
-        if((_child_to_parent_classmap).find(real_parent)== _child_to_parent_classmap.end()){
-            break;
-        }
-        real_parent = (_child_to_parent_classmap).find(real_parent)->second;  
-    }
-    }
-    std::list<Symbol>::iterator it;
-    for (it = real_parents.begin(); it != real_parents.end(); ++it){
-        Symbol found_parent = *it; 
-        if ( found_parent == supposed_parent) return true;
+    std::map<Symbol,int>::iterator c = _tree_index.find(child);
+    std::map<Symbol,int>::iterator p = _tree_index.find(supposed_parent);
+    if (c == _tree_index.end() || p == _tree_index.end()) return false;
+
+    return is_tree_ancestor(p->second, c->second);
+}
+
+/*
+    The join of two types is their lowest common ancestor. If neither is
+    an ancestor of the other, lift symbol1 by decreasing powers of two as
+    long as it stays below the join; its parent is then the join.
+*/
+Symbol ClassTable::least_upper_bound(Symbol symbol1, Symbol symbol2, Symbol class_symbol)
+{
+    if (symbol1 == symbol2) return symbol1;
+    if (symbol1 == SELF_TYPE) symbol1 = class_symbol;
+    if (symbol2 == SELF_TYPE) symbol2 = class_symbol;
+
+    std::map<Symbol,int>::iterator it1 = _tree_index.find(symbol1);
+    std::map<Symbol,int>::iterator it2 = _tree_index.find(symbol2);
+    if (it1 == _tree_index.end() || it2 == _tree_index.end()) return Object;
+
+    int a = it1->second;
+    int b = it2->second;
+    if (is_tree_ancestor(a, b)) return _tree_class[a];
+    if (is_tree_ancestor(b, a)) return _tree_class[b];
+
+    for (int k = _ancestor.size() - 1; k >= 0; k--)
+    {
+        if (!is_tree_ancestor(_ancestor[k][a], b))
+            a = _ancestor[k][a];
     }
-    return false;
+    return _tree_class[_ancestor[0][a]];
 }
@@ -12,6 +12,8 @@
 #include <vector>
 #include <set>
 #include <utility>
+#include <deque>
+#include <sstream>
 
 #define TRUE 1
 #define FALSE 0
@@ -19,6 +21,15 @@
 class ClassTable;
 typedef ClassTable *ClassTableP;
 
+// Errors found while checking one class. Classes are checked on worker
+// threads, so each keeps its own buffer and they are printed in class
+// order once every class is done.
+struct ClassErrors {
+  std::ostringstream text;
+  int count;
+  ClassErrors() : count(0) { }
+};
+
 // This is a structure that may be used to contain the semantic
 // information such as the inheritance graph.  You may use it or not as
 // you like: it is only here to provide a container for the supplied
@@ -34,6 +45,17 @@ private:
   std::map<Symbol,Symbol> _child_to_parent_classmap;
   std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > _method_map;
   std::map<Symbol, Class_> _declared_classes_map;
+  // the inheritance tree numbered from Object: each class has an index,
+  // the [preorder, postorder] DFS interval of its subtree, and its 2^k-th
+  // ancestors for least upper bound queries
+  std::map<Symbol,int> _tree_index;
+  std::vector<Symbol> _tree_class;
+  std::vector<int> _preorder;
+  std::vector<int> _postorder;
+  std::vector<std::vector<int> > _ancestor;
+  // every method visible in each class, inherited ones included, by tree
+  // index; the signatures point into _method_map
+  std::vector<std::map<Symbol, const std::vector<Symbol> *> > _class_methods;
   int semant_errors;
   
   void install_basic_classes();
@@ -42,23 +64,67 @@ private:
   void verify_parent_classes_are_defined();
   void add_class_methods_to_method_map(Class__class *curr_class);
   void populate_child_parent_and_unique_ID_maps();
+  void number_inheritance_tree();
+  void number_class(Symbol curr_class, int parent_index, std::map<Symbol, std::vector<Symbol> > & children, int & counter);
+  void build_class_method_tables();
+  bool is_tree_ancestor(int ancestor, int descendant)
+    { return _preorder[ancestor] <= _preorder[descendant] && _postorder[descendant] <= _postorder[ancestor]; }
 
   ostream& error_stream;
+  // the buffer of the class the calling thread is checking, if any
+  static thread_local ClassErrors *class_errors;
 public:
 
   ClassTable(Classes);
-  std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > get_method_map();
-  std::map<Symbol,Symbol> get_child_map(){ return _child_to_parent_classmap; }
-  std::map<Symbol,Class_> get_class_map(){ return _declared_classes_map; }
-  std::set<Symbol> get_class_set(){ return _valid_classes; }
+  const std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & get_method_map(){ return _method_map; }
+  const std::map<Symbol,Symbol> & get_child_map(){ return _child_to_parent_classmap; }
+  const std::map<Symbol,Class_> & get_class_map(){ return _declared_classes_map; }
+  const std::set<Symbol> & get_class_set(){ return _valid_classes; }
   int errors() { return semant_errors; }
   ostream& semant_error();
   ostream& semant_error(Class_ c);
   ostream& semant_error(Symbol filename, tree_node *t);
-  ostream& get_error_stream(){ return error_stream;}
+  ostream& get_error_stream(){ return class_errors ? class_errors->text : error_stream; }
+  static void set_class_errors(ClassErrors *errors){ class_errors = errors; }
+  void merge_class_errors(ClassErrors & errors);
   Classes get_class_list(){return _classes;}
-  bool is_subtypeof(  Symbol child, Symbol supposed_parent, 
-                                        std::map<Symbol,Symbol> _child_to_parent_classmap );
+  bool is_subtypeof(Symbol child, Symbol supposed_parent, Symbol class_symbol);
+  Symbol least_upper_bound(Symbol symbol1, Symbol symbol2, Symbol class_symbol);
+  const std::vector<Symbol> *lookup_method(Symbol class_name, Symbol method_name);
+};
+
+// The type environment handed to every type_check call. It is built once
+// in program_class::semant() after the ClassTable is complete and only
+// refers to the ClassTable's tables, so passing it by reference copies
+// nothing. Errors are still reported through the ClassTable.
+class TypeEnv {
+public:
+  ClassTableP classtable;
+  const std::map<Symbol,Symbol> & child_to_parent_classmap;
+  const std::map<std::pair<Symbol,Symbol>,std::vector<Symbol> > & method_map;
+  const std::map<Symbol,Class_> & declared_classes_map;
+  const std::set<Symbol> & valid_classes;
+
+  TypeEnv(ClassTableP ct) : classtable(ct),
+                            child_to_parent_classmap(ct->get_child_map()),
+                            method_map(ct->get_method_map()),
+                            declared_classes_map(ct->get_class_map()),
+                            valid_classes(ct->get_class_set()) { }
+};
+
+// Per-class symbol tables, built once. A class's table chains onto its
+// parent's, so inherited attributes are shared rather than re-added, and
+// checking a feature only pushes its formals.
+class ClassScopes {
+private:
+  std::map<Symbol, SymbolTable<Symbol,Symbol> > _scopes;
+  std::deque<Symbol> _types;
+  SymbolTable<Symbol,Symbol> _base;
+
+  SymbolTable<Symbol,Symbol> & build(const TypeEnv & env, Symbol curr_class);
+public:
+  ClassScopes(const TypeEnv & env);
+  SymbolTable<Symbol,Symbol> scope_of(Symbol curr_class);
 };
 
 